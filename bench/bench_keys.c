@@ -0,0 +1,160 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define IMPL_CJ
+#include "../cj.h"
+
+// Dispatch the keys of wide objects to struct fields: with a chain of cj_span_eq calls (one per field), with a
+// cj_key_matcher and with a cj_binding that writes into the structs without any callbacks.
+
+#define FIELDS 60
+#define DOC_RECORDS 20000
+#define RUNS 5
+
+char field_names[FIELDS][32];
+const char* field_keys[FIELDS];
+
+struct record {
+    int values[FIELDS];
+};
+
+struct document {
+    struct record records[DOC_RECORDS];
+    size_t count;
+};
+
+char* generate_document(size_t* length) {
+    char* doc = malloc(DOC_RECORDS * FIELDS * 48);
+    char* out = doc;
+    out += sprintf(out, "{\"records\": [");
+    for (int i = 0; i < DOC_RECORDS; i++) {
+        out += sprintf(out, "%s{", i == 0 ? "" : ",");
+        for (int f = 0; f < FIELDS; f++) {
+            // the fields are not in the order of the struct
+            out += sprintf(out, "%s\"%s\":%d", f == 0 ? "" : ",", field_keys[(f * 7) % FIELDS], f);
+        }
+        out += sprintf(out, "}");
+    }
+    out += sprintf(out, "]}");
+    *length = out - doc;
+    return doc;
+}
+
+struct record record;
+struct cj_key_matcher matcher;
+
+enum cj_error_code set_chain(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    for (int f = 0; f < FIELDS; f++) {
+        if (cj_span_eq(id, (char*)field_keys[f])) {
+            record.values[f] = value->number.integer;
+            break;
+        }
+    }
+    return cj_error_none;
+}
+
+enum cj_error_code set_matcher(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    int f = cj_key_matcher_find(&matcher, id);
+    if (f != -1) {
+        record.values[f] = value->number.integer;
+    }
+    return cj_error_none;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+double bench(struct cj_parser* parser, char* doc, size_t length) {
+    double best = 1e9;
+    for (int i = 0; i < RUNS; i++) {
+        double start = now();
+        struct cj_error err = cj_parse_object_into_n(parser, doc, length, NULL, 0);
+        double t = now() - start;
+        if (err.type != cj_error_none) {
+            printf("parser failed: %s\n", cj_error_message[err.type].str);
+            exit(EXIT_FAILURE);
+        }
+        best = t < best ? t : best;
+    }
+    return best;
+}
+
+struct document document;
+
+double bench_binding(struct cj_binding* binding, char* doc, size_t length) {
+    double best = 1e9;
+    for (int i = 0; i < RUNS; i++) {
+        double start = now();
+        struct cj_error err = cj_parse_bound(binding, doc, length, &document);
+        double t = now() - start;
+        if (err.type != cj_error_none || document.count != DOC_RECORDS) {
+            printf("binding failed: %s\n", cj_error_message[err.type].str);
+            exit(EXIT_FAILURE);
+        }
+        best = t < best ? t : best;
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    for (int f = 0; f < FIELDS; f++) {
+        sprintf(field_names[f], "field_number_%d", f);
+        field_keys[f] = field_names[f];
+    }
+    if (cj_key_matcher_init(&matcher, field_keys, FIELDS) != cj_error_none) {
+        return EXIT_FAILURE;
+    }
+
+    struct cj_field record_fields[FIELDS];
+    for (int f = 0; f < FIELDS; f++) {
+        record_fields[f] = (struct cj_field){
+            .key = field_keys[f], .type = cj_field_int, .offset = offsetof(struct record, values) + f * sizeof(int)};
+    }
+    struct cj_binding record_binding;
+    struct cj_field record_element = {.type = cj_field_object, .binding = &record_binding};
+    struct cj_field document_fields[] = {{.key = "records",
+                                          .type = cj_field_array,
+                                          .offset = offsetof(struct document, records),
+                                          .size = sizeof(struct record),
+                                          .capacity = DOC_RECORDS,
+                                          .count_offset = offsetof(struct document, count),
+                                          .element = &record_element}};
+    struct cj_binding document_binding;
+    if (cj_binding_init(&record_binding, record_fields, FIELDS) != cj_error_none ||
+        cj_binding_init(&document_binding, document_fields, 1) != cj_error_none) {
+        return EXIT_FAILURE;
+    }
+
+    size_t length = 0;
+    char* doc = generate_document(&length);
+    printf("document: %.1f MB, %d fields per object\n", length / 1e6, FIELDS);
+
+    struct cj_parser parser = {.open = cj_open_void, .push = cj_push_void, .set = set_chain};
+    double chain = bench(&parser, doc, length);
+    parser.set = set_matcher;
+    double matched = bench(&parser, doc, length);
+    double bound = bench_binding(&document_binding, doc, length);
+
+    printf("cj_span_eq chain: %8.1f MB/s\n", length / 1e6 / chain);
+    printf("cj_key_matcher:   %8.1f MB/s\n", length / 1e6 / matched);
+    printf("cj_binding:       %8.1f MB/s\n", length / 1e6 / bound);
+
+    cj_binding_free(&document_binding);
+    cj_binding_free(&record_binding);
+    cj_key_matcher_free(&matcher);
+    free(doc);
+    return EXIT_SUCCESS;
+}
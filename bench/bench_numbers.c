@@ -0,0 +1,157 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define IMPL_CJ
+#include "../cj.h"
+
+// Parse arrays of the long integers and timestamps found in typical payloads, once with cj_parse_number alone and
+// through the whole parser, with one push per number, with push_batch and straight into a cj_number_array of doubles.
+// Build with -DCJ_NO_SIMD to compare against the digit at a time loops.
+
+#define NUMBERS 1000000
+#define RUNS 10
+
+uint64_t rng_state = 0x9E3779B97F4A7C15ULL;
+
+uint64_t rng() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 7;
+    rng_state ^= rng_state << 17;
+    return rng_state;
+}
+
+enum number_kind {
+    kind_id,
+    kind_timestamp_ms,
+    kind_timestamp_ns,
+    kind_timestamp_s,
+};
+
+const char* kind_name[] = {"ids (10-19 digits)", "timestamps ms", "timestamps ns", "timestamps s.us"};
+
+char* generate_array(enum number_kind kind, size_t* length) {
+    char* doc = malloc(NUMBERS * 24 + 2);
+    char* out = doc;
+    uint64_t timestamp = 1700000000000000000ULL;
+    *out++ = '[';
+    for (size_t i = 0; i < NUMBERS; i++) {
+        timestamp += rng() % 1000000000;
+        switch (kind) {
+            case kind_id: {
+                uint64_t digits = 10 + rng() % 10;
+                uint64_t id = rng() % 9 + 1;
+                for (uint64_t d = 1; d < digits; d++) {
+                    id = id * 10 + rng() % 10;
+                }
+                out += sprintf(out, "%llu", (unsigned long long)id);
+                break;
+            }
+            case kind_timestamp_ms:
+                out += sprintf(out, "%llu", (unsigned long long)(timestamp / 1000000));
+                break;
+            case kind_timestamp_ns:
+                out += sprintf(out, "%llu", (unsigned long long)timestamp);
+                break;
+            case kind_timestamp_s:
+                out += sprintf(out, "%llu.%06llu", (unsigned long long)(timestamp / 1000000000),
+                               (unsigned long long)(timestamp / 1000 % 1000000));
+                break;
+        }
+        *out++ = i + 1 < NUMBERS ? ',' : ']';
+    }
+    *length = out - doc;
+    return doc;
+}
+
+uint64_t batch_sink;
+
+enum cj_error_code push_batch_sum(void* this, unsigned int tag, size_t index, struct cj_value* values, size_t count) {
+    (void)this;
+    (void)tag;
+    (void)index;
+    for (size_t i = 0; i < count; i++) {
+        batch_sink += values[i].number.type;
+    }
+    return cj_error_none;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+#if defined(CJ_SWAR_DIGITS)
+    printf("numbers (SWAR digits)\n");
+#else
+    printf("numbers (scalar digits)\n");
+#endif
+
+    struct cj_parser parser = {.open = cj_open_void, .push = cj_push_void, .set = cj_set_void};
+    struct cj_parser batch_parser = {
+        .open = cj_open_void, .push = cj_push_void, .set = cj_set_void, .push_batch = push_batch_sum};
+    double* values = malloc(NUMBERS * sizeof(double));
+    struct cj_number_array array = {.type = cj_number_array_double, .values = values, .capacity = NUMBERS};
+    for (enum number_kind kind = kind_id; kind <= kind_timestamp_s; kind++) {
+        size_t length = 0;
+        char* doc = generate_array(kind, &length);
+        char* end = doc + length;
+
+        double best_number = 1e9, best_parse = 1e9, best_batch = 1e9, best_array = 1e9;
+        volatile uint64_t sink = 0;
+        for (int i = 0; i < RUNS; i++) {
+            double start = now();
+            for (char* b = doc + 1; b < end; b++) {
+                struct cj_value value;
+                if (cj_parse_number(&b, end, &value) != cj_error_none) {
+                    printf("cj_parse_number failed\n");
+                    return EXIT_FAILURE;
+                }
+                sink += value.number.type;
+            }
+            double t = now() - start;
+            best_number = t < best_number ? t : best_number;
+
+            start = now();
+            struct cj_error err = cj_parse_array_into_n(&parser, doc, length, NULL, 0);
+            t = now() - start;
+            if (err.type != cj_error_none) {
+                printf("parser failed: %s\n", cj_error_message[err.type].str);
+                return EXIT_FAILURE;
+            }
+            best_parse = t < best_parse ? t : best_parse;
+
+            start = now();
+            err = cj_parse_array_into_n(&batch_parser, doc, length, NULL, 0);
+            t = now() - start;
+            if (err.type != cj_error_none) {
+                printf("parser failed: %s\n", cj_error_message[err.type].str);
+                return EXIT_FAILURE;
+            }
+            best_batch = t < best_batch ? t : best_batch;
+
+            start = now();
+            err = cj_parse_number_array_into(doc, length, &array);
+            t = now() - start;
+            if (err.type != cj_error_none || array.count != NUMBERS) {
+                printf("cj_parse_number_array_into failed: %s\n", cj_error_message[err.type].str);
+                return EXIT_FAILURE;
+            }
+            best_array = t < best_array ? t : best_array;
+        }
+
+        printf("%-20s cj_parse_number: %6.1f ns/number %8.1f MB/s, parser: %8.1f MB/s, push_batch: %8.1f MB/s, "
+               "number array: %8.1f MB/s\n",
+               kind_name[kind], best_number * 1e9 / NUMBERS, length / 1e6 / best_number, length / 1e6 / best_parse,
+               length / 1e6 / best_batch, length / 1e6 / best_array);
+        free(doc);
+    }
+    free(values);
+    return EXIT_SUCCESS;
+}
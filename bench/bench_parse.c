@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define IMPL_CJ
+#include "../cj.h"
+
+// Compare the recursive descent parser, cj_validate and the cj_decode DOM build (with copied and in situ decoded
+// strings, and into the arena of a reused cj_parse_ctx) on a generated multi megabyte document.
+
+#define DOC_RECORDS 100000
+#define RUNS 10
+
+char* generate_document(size_t* length) {
+    size_t capacity = DOC_RECORDS * 256;
+    char* doc = malloc(capacity);
+    char* out = doc;
+    out += sprintf(out, "[\n");
+    for (int i = 0; i < DOC_RECORDS; i++) {
+        out += sprintf(out,
+                       "    {\n"
+                       "        \"id\": %d,\n"
+                       "        \"name\": \"record number %d with a \\\"quoted\\\" name\",\n"
+                       "        \"score\": %d.%d,\n"
+                       "        \"active\": %s,\n"
+                       "        \"tags\": [\"alpha\", \"beta\", \"gamma\", \"\xce\xb4\xce\xad\xce\xbb\xcf\x84\xce\xb1\"],\n"
+                       "        \"parent\": null\n"
+                       "    }%s\n",
+                       i, i, i % 100, i % 7, i % 2 ? "true" : "false", i + 1 < DOC_RECORDS ? "," : "");
+    }
+    out += sprintf(out, "]\n");
+    *length = out - doc;
+    return doc;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    size_t length = 0;
+    char* doc = generate_document(&length);
+    char* insitu = malloc(length);
+    struct cj_parser parser = {.open = cj_open_void, .push = cj_push_void, .set = cj_set_void};
+
+    printf("document: %.1f MB\n", length / 1e6);
+
+    double best_recursive = 1e9, best_validate = 1e9, best_utf8 = 1e9, best_decode = 1e9, best_insitu = 1e9,
+           best_ctx = 1e9;
+    struct cj_parse_ctx ctx;
+    if (cj_parse_ctx_init(&ctx, 0) != cj_error_none) {
+        return EXIT_FAILURE;
+    }
+    struct cj_parser utf8_parser = parser;
+    utf8_parser.flags = cj_parse_validate_utf8;
+    for (int i = 0; i < RUNS; i++) {
+        double start = now();
+        struct cj_error err = cj_parse_array_into_n(&parser, doc, length, NULL, 0);
+        double t = now() - start;
+        if (err.type != cj_error_none) {
+            printf("recursive descent parser failed: %s\n", cj_error_message[err.type].str);
+            return EXIT_FAILURE;
+        }
+        best_recursive = t < best_recursive ? t : best_recursive;
+
+        start = now();
+        if (!cj_validate(doc, length, NULL)) {
+            printf("validation failed\n");
+            return EXIT_FAILURE;
+        }
+        t = now() - start;
+        best_validate = t < best_validate ? t : best_validate;
+
+        start = now();
+        err = cj_parse_array_into_n(&utf8_parser, doc, length, NULL, 0);
+        t = now() - start;
+        if (err.type != cj_error_none) {
+            printf("recursive descent parser with UTF-8 validation failed: %s\n", cj_error_message[err.type].str);
+            return EXIT_FAILURE;
+        }
+        best_utf8 = t < best_utf8 ? t : best_utf8;
+
+        start = now();
+        struct cj_entity* root = cj_decode_n(doc, length, &err);
+        t = now() - start;
+        if (root == NULL) {
+            printf("decode failed: %s\n", cj_error_message[err.type].str);
+            return EXIT_FAILURE;
+        }
+        cj_entity_free(root);
+        best_decode = t < best_decode ? t : best_decode;
+
+        // in situ decoding overwrites the input, every run needs a fresh copy
+        memcpy(insitu, doc, length);
+        start = now();
+        root = cj_decode_insitu(insitu, length, 0, &err);
+        t = now() - start;
+        if (root == NULL) {
+            printf("in situ decode failed: %s\n", cj_error_message[err.type].str);
+            return EXIT_FAILURE;
+        }
+        cj_entity_free_insitu(root);
+        best_insitu = t < best_insitu ? t : best_insitu;
+
+        // the first run grows the arena, later runs do not allocate
+        start = now();
+        root = cj_decode_ctx(&ctx, doc, length, 0, &err);
+        t = now() - start;
+        if (root == NULL) {
+            printf("decode with context failed: %s\n", cj_error_message[err.type].str);
+            return EXIT_FAILURE;
+        }
+        cj_parse_ctx_reset(&ctx);
+        best_ctx = t < best_ctx ? t : best_ctx;
+    }
+
+    printf("recursive descent: %8.1f MB/s\n", length / 1e6 / best_recursive);
+    printf("validate:          %8.1f MB/s\n", length / 1e6 / best_validate);
+    printf("recursive + UTF-8: %8.1f MB/s\n", length / 1e6 / best_utf8);
+    printf("decode (DOM):      %8.1f MB/s\n", length / 1e6 / best_decode);
+    printf("decode (in situ):  %8.1f MB/s\n", length / 1e6 / best_insitu);
+    printf("decode (context):  %8.1f MB/s\n", length / 1e6 / best_ctx);
+
+    cj_parse_ctx_free(&ctx);
+    free(insitu);
+    free(doc);
+    return EXIT_SUCCESS;
+}
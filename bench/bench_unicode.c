@@ -0,0 +1,84 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define IMPL_CJ
+#include "../cj.h"
+
+// Decode documents full of \u escapes at growing sizes. Decoding must scale linearly with the size of the input, the
+// time per byte of the largest document may not be much larger than the one of the smallest.
+
+#define RUNS 5
+#define MAX_SLOWDOWN 2.0
+
+/**
+ * Generate an array of strings with about size bytes, every string is one long run of escaped non-ASCII text including
+ * surrogate pairs, the last string covers half of the document.
+ */
+char* generate_document(size_t size, size_t* length) {
+    static const char* escapes[] = {"\\u00e4", "\\u00f6", "\\u20ac", "\\ud83d\\ude00", "\\u0041", "\\n", "x"};
+    char* doc = malloc(size + 64);
+    char* out = doc;
+    out += sprintf(out, "[");
+    for (size_t part = 0; part < 2; part++) {
+        size_t limit = part == 0 ? size / 2 : size - 16;
+        size_t string_length = part == 0 ? 256 : limit;
+        while ((size_t)(out - doc) < limit) {
+            char* string_start = out;
+            out += sprintf(out, "%s\"", out - doc > 1 ? "," : "");
+            for (size_t i = 0; (size_t)(out - string_start) < string_length && (size_t)(out - doc) < limit; i++) {
+                out += sprintf(out, "%s", escapes[i % (sizeof(escapes) / sizeof(escapes[0]))]);
+            }
+            out += sprintf(out, "\"");
+        }
+    }
+    out += sprintf(out, "]");
+    *length = out - doc;
+    return doc;
+}
+
+double now() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int main(int argc, char* argv[]) {
+    (void)argc;
+    (void)argv;
+
+    double first_ns_per_byte = 0;
+    double last_ns_per_byte = 0;
+    for (size_t mb = 1; mb <= 16; mb *= 2) {
+        size_t length = 0;
+        char* doc = generate_document(mb << 20, &length);
+
+        double best = 1e9;
+        for (int i = 0; i < RUNS; i++) {
+            struct cj_error err;
+            double start = now();
+            struct cj_entity* e = cj_decode_n(doc, length, &err);
+            double t = now() - start;
+            if (e == NULL) {
+                printf("decode failed: %s\n", cj_error_message[err.type].str);
+                return EXIT_FAILURE;
+            }
+            cj_entity_free(e);
+            best = t < best ? t : best;
+        }
+
+        last_ns_per_byte = best * 1e9 / length;
+        if (first_ns_per_byte == 0) {
+            first_ns_per_byte = last_ns_per_byte;
+        }
+        printf("%5.1f MB: %8.1f MB/s %6.2f ns/byte\n", length / 1e6, length / 1e6 / best, last_ns_per_byte);
+        free(doc);
+    }
+
+    if (last_ns_per_byte > first_ns_per_byte * MAX_SLOWDOWN) {
+        printf("decoding does not scale linearly\n");
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -18,6 +18,7 @@ You should have received a copy of the GNU Affero General Public License along w
 #define CJ_H
 #include <float.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * Enum of all posible error codes
@@ -42,6 +43,16 @@ enum cj_error_code {
     cj_error_duplicated_key,
     cj_error_not_equal,
     cj_error_span_not_enclosed_by_quotes,
+    cj_error_max_depth,
+    cj_error_out_of_memory,
+    cj_error_skip,
+    cj_error_invalid_utf8,
+    cj_error_type_mismatch,
+    cj_error_array_capacity,
+    cj_error_number_array,
+    cj_error_unpaired_surrogate,
+    cj_error_control_character,
+    cj_error_invalid_field,
 };
 
 /**
@@ -70,6 +81,16 @@ struct {
     {cj_error_duplicated_key, "duplicate key in object"},
     {cj_error_not_equal, "decoded string does not match"},
     {cj_error_span_not_enclosed_by_quotes, "span not enclosed by quotes"},
+    {cj_error_max_depth, "maximum nesting depth exceeded"},
+    {cj_error_out_of_memory, "out of memory"},
+    {cj_error_skip, "container skipped"},
+    {cj_error_invalid_utf8, "invalid UTF-8 in string"},
+    {cj_error_type_mismatch, "value does not match the type of the bound field or number array"},
+    {cj_error_array_capacity, "array has more items than the bound field or number array can hold"},
+    {cj_error_number_array, "container parsed as number array"},
+    {cj_error_unpaired_surrogate, "expecting a \\u escape of a low surrogate right after each high surrogate"},
+    {cj_error_control_character, "characters below 0x20 have to be escaped in strings"},
+    {cj_error_invalid_field, "cj_field_chars needs a size of at least 1 for the '\\0'"},
 };
 
 /**
@@ -84,29 +105,75 @@ struct cj_error {
 };
 
 /**
- * A simple string + length struct
+ * Flags in cj_span.info, a span without cj_span_info_scanned (e.g. one built by hand) has an unknown decoded length.
+ */
+enum cj_span_info {
+    cj_span_info_scanned = 1 << 0,
+    cj_span_info_escaped = 1 << 1,
+    /**
+     * The span was decoded in place (see cj_parse_insitu), ptr points to the '\0' terminated decoded string without
+     * quotes and length is its length.
+     */
+    cj_span_info_decoded = 1 << 2,
+    /**
+     * hash holds cj_hash of the decoded string. Set by the parser for keys without escapes or decoded in place.
+     */
+    cj_span_info_hashed = 1 << 3,
+};
+
+/**
+ * A simple string + length struct. Strings found by the parser also carry their decoded length and whether they
+ * contain escape sequences, escape free strings are compared and copied without decoding.
  */
 struct cj_span {
     char* ptr;
     size_t length;
+    size_t decoded_length;
+    unsigned int info;
+    uint32_t hash;
 };
 
+/**
+ * Hash length bytes at str, the same hash the parser stores in cj_span.hash of keys. Compare it with the hash of a key
+ * literal to dispatch keys without reading them again.
+ */
+uint32_t cj_hash(const char* str, size_t length);
+
 /**
  * A enum containing all possible numeric types.
  */
 enum cj_numeric_type{
     cj_numeric_type_integer,
     cj_numeric_type_decimal,
+    cj_numeric_type_integer64,
+    cj_numeric_type_uinteger64,
+    cj_numeric_type_decimal64,
+    cj_numeric_type_integer_span,
+    cj_numeric_type_decimal_span,
 };
 
 /**
  * A struct representing a numeric value, either an integer or a decimal. The type field is used to store this additional inforamtion.
+ *
+ * The parser picks the type while scanning a number: integers in the range of int are integer, wider integers are
+ * integer64 or, if they are positive and only fit unsigned, uinteger64. Numbers with a fraction or an exponent and
+ * integers beyond 64 bits are decimal64. The parser never produces decimal, it is left for encoding floats.
+ *
+ * With cj_parse_lazy_numbers the parser does not convert numbers, text holds the unmodified text of the number and the
+ * type is integer_span or decimal_span if it has a fraction or an exponent. See cj_numeric_from_text.
  */
 struct cj_numeric {
     enum cj_numeric_type type;
     union {
         int integer;
         float decimal;
+        int64_t integer64;
+        uint64_t uinteger64;
+        double decimal64;
+        struct {
+            const char* ptr;
+            size_t length;
+        } text;
     };
 };
 
@@ -120,6 +187,28 @@ struct cj_numeric cj_numeric_integer(int v);
  */
 struct cj_numeric cj_numeric_decimal(float v);
 
+/**
+ * Create a new cj_numeric of a 64 bit integer value.
+ */
+struct cj_numeric cj_numeric_integer64(int64_t v);
+
+/**
+ * Create a new cj_numeric of a 64 bit unsigned integer value.
+ */
+struct cj_numeric cj_numeric_uinteger64(uint64_t v);
+
+/**
+ * Create a new cj_numeric of a double value.
+ */
+struct cj_numeric cj_numeric_decimal64(double v);
+
+/**
+ * Convert the text of a number, for example the text of a cj_numeric_type_integer_span or cj_numeric_type_decimal_span,
+ * to the type the parser would pick without cj_parse_lazy_numbers. Returns an error and leaves out untouched if text
+ * does not hold exactly one number.
+ */
+enum cj_error_code cj_numeric_from_text(const char* text, size_t length, struct cj_numeric* out);
+
 /**
  * A union type holding an index(size_t) or an id(cj_span). More context is need to know which it acually is.
  */
@@ -162,14 +251,77 @@ enum cj_container_type {
     cj_container_object,
 };
 
+/**
+ * Options for cj_parser and cj_decode_flags, combine them with |.
+ */
+enum cj_parse_flag {
+    /**
+     * Check that the input is well-formed UTF-8 before parsing, which covers the content of all strings and keys. Fails
+     * with cj_error_invalid_utf8 before any callback is called.
+     */
+    cj_parse_validate_utf8 = 1 << 0,
+    /**
+     * Hand numbers to the callbacks as their raw text instead of converting them, see cj_numeric_type_integer_span.
+     * Ignored by cj_decode_flags.
+     */
+    cj_parse_lazy_numbers = 1 << 1,
+    /**
+     * Decode every string and key in place inside the input and terminate it with '\0', the spans handed to the
+     * callbacks point to the decoded strings (see cj_span_info_decoded) and stay valid as long as the input. The line
+     * and column of errors are counted in the partly decoded input. Only cj_parse_object_into_insitu,
+     * cj_parse_array_into_insitu and cj_decode_insitu write to their input, all other entry points ignore this flag.
+     */
+    cj_parse_insitu = 1 << 2,
+};
+
+/**
+ * Maximum number of values handed to cj_parser.push_batch at once. The buffer of CJ_PUSH_BATCH values is only needed if
+ * push_batch is set, it is then taken from cj_parser.ctx or allocated once per document.
+ */
+#ifndef CJ_PUSH_BATCH
+#define CJ_PUSH_BATCH 64
+#endif
+
+/**
+ * Default for cj_parser.max_depth and the limit of cj_validate and of containers skipped with cj_error_skip.
+ */
+#ifndef CJ_MAX_DEPTH
+#define CJ_MAX_DEPTH 1024
+#endif
+
+struct cj_parse_ctx;
+
 /**
  * A struct holding three pointers to user defined functions used for allocating and linking parsed strucutes together.
+ * If open returns cj_error_skip the container and everything inside of it is skipped without any further callbacks,
+ * not even the push or set of the skipped container itself. If open returns cj_error_number_array for an array, *open
+ * must point to a struct cj_number_array, the numbers of the array are parsed straight into it like with
+ * cj_parse_number_array_into and the parent receives the array without any callbacks for its elements.
  */
 struct cj_parser {
     enum cj_error_code (*open)(enum cj_container_type type, void* parent, unsigned int parent_tag, union cj_key* key,
                                void** open, unsigned int* tag);
     enum cj_error_code (*push)(void* this, unsigned int tag, size_t index, struct cj_value* value);
     enum cj_error_code (*set)(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value);
+    /**
+     * Optional, if not NULL the strings, numbers, booleans and nulls of arrays are collected and handed over in runs of
+     * up to CJ_PUSH_BATCH values instead of one push call each, index is the index of values[0]. Objects and arrays
+     * inside of arrays are still handed to push. The values are only valid during the call.
+     */
+    enum cj_error_code (*push_batch)(void* this, unsigned int tag, size_t index, struct cj_value* values, size_t count);
+    /**
+     * Maximum number of nested objects and arrays including the root container, deeper documents fail with
+     * cj_error_max_depth. 0 selects CJ_MAX_DEPTH.
+     */
+    size_t max_depth;
+    /**
+     * A combination of enum cj_parse_flag values.
+     */
+    unsigned int flags;
+    /**
+     * Optional, keeps the working memory of the parser (container stack and push_batch buffer) between documents.
+     */
+    struct cj_parse_ctx* ctx;
 };
 
 /**
@@ -192,11 +344,43 @@ enum cj_error_code cj_set_void(void* this, unsigned int tag, struct cj_span* id,
  */
 struct cj_error cj_parse_object_into(struct cj_parser* parser, char* b, void* object, unsigned int object_type);
 
+/**
+ * Parse the first length bytes of b as a json object, see cj_parse_object_into. b does not need to be '\0' terminated,
+ * which allows parsing slices of larger buffers.
+ */
+struct cj_error cj_parse_object_into_n(struct cj_parser* parser, const char* b, size_t length, void* object,
+                                       unsigned int object_type);
+
 /**
  * Parse a json array into a user defined structure using cj_parser for allocating and link the data structures.
  */
 struct cj_error cj_parse_array_into(struct cj_parser* parser, char* b, void* array, unsigned int array_type);
 
+/**
+ * Parse the first length bytes of b as a json array, see cj_parse_array_into. b does not need to be '\0' terminated.
+ */
+struct cj_error cj_parse_array_into_n(struct cj_parser* parser, const char* b, size_t length, void* array,
+                                      unsigned int array_type);
+
+/**
+ * Like cj_parse_object_into_n with cj_parse_insitu set: strings and keys are decoded in place, b must be writable.
+ */
+struct cj_error cj_parse_object_into_insitu(struct cj_parser* parser, char* b, size_t length, void* object,
+                                            unsigned int object_type);
+
+/**
+ * Like cj_parse_array_into_n with cj_parse_insitu set: strings and keys are decoded in place, b must be writable.
+ */
+struct cj_error cj_parse_array_into_insitu(struct cj_parser* parser, char* b, size_t length, void* array,
+                                           unsigned int array_type);
+
+/**
+ * Check that the first length bytes of b contain exactly one json value, surrounded by optional white space. Only the
+ * grammar is checked: no callbacks are called and no memory is allocated. Nesting deeper than CJ_MAX_DEPTH is reported
+ * as cj_error_max_depth. Returns true for valid json, otherwise false and the error is stored in error (if not NULL).
+ */
+bool cj_validate(const char* b, size_t length, struct cj_error* error);
+
 /**
  * An enum of all posible parent types of entities (array, object, root).
  */
@@ -261,11 +445,88 @@ struct cj_entity* cj_entity_get_item(struct cj_entity* e, unsigned int);
  */
 void cj_entity_free(struct cj_entity* e);
 
+/**
+ * Free a cj_entity allocated by cj_decode_insitu. Strings and ids point into the input and are not freed, the input
+ * has to be freed by the caller after the tree.
+ */
+void cj_entity_free_insitu(struct cj_entity* e);
+
 /**
  * Parse and decode json string into a tree of cj_entity instances.
  */
 struct cj_entity* cj_decode(char* b, struct cj_error* error);
 
+/**
+ * Parse and decode the first length bytes of b into a tree of cj_entity instances. b does not need to be '\0'
+ * terminated.
+ */
+struct cj_entity* cj_decode_n(const char* b, size_t length, struct cj_error* error);
+
+/**
+ * Like cj_decode_n with a combination of enum cj_parse_flag values.
+ */
+struct cj_entity* cj_decode_flags(const char* b, size_t length, unsigned int flags, struct cj_error* error);
+
+/**
+ * Like cj_decode_flags but strings and ids are decoded in place (see cj_parse_insitu), the tree does not allocate any
+ * strings and points into b. b must stay valid until the tree is freed with cj_entity_free_insitu.
+ */
+struct cj_entity* cj_decode_insitu(char* b, size_t length, unsigned int flags, struct cj_error* error);
+
+struct cj_parse_ctx_block;
+
+/**
+ * Working memory reused between documents: the container stack of deeply nested documents, the values collected for
+ * cj_parser.push_batch and an arena for decoded trees and strings. Once it has grown to what the largest document
+ * needs, parsing with it does not allocate any more. Set cj_parser.ctx or use cj_decode_ctx, a context serves one
+ * document at a time. Initialize it with cj_parse_ctx_init, call cj_parse_ctx_reset between documents and
+ * cj_parse_ctx_free at the end.
+ */
+struct cj_parse_ctx {
+    void* frames;
+    size_t frames_capacity;
+    struct cj_value* batch;
+    /**
+     * The blocks of the arena, allocations are taken from the first one.
+     */
+    struct cj_parse_ctx_block* blocks;
+    size_t arena_capacity;
+};
+
+/**
+ * Initialize ctx with an arena of arena_size bytes, which may be 0. Returns cj_error_none or cj_error_out_of_memory.
+ */
+enum cj_error_code cj_parse_ctx_init(struct cj_parse_ctx* ctx, size_t arena_size);
+
+/**
+ * Release everything allocated from the arena of ctx, the trees of cj_decode_ctx become invalid. If the arena had to
+ * grow during the last document its blocks are merged into one that fits the whole document.
+ */
+void cj_parse_ctx_reset(struct cj_parse_ctx* ctx);
+
+/**
+ * Free all memory of ctx.
+ */
+void cj_parse_ctx_free(struct cj_parse_ctx* ctx);
+
+/**
+ * Allocate size bytes (aligned for any type) from the arena of ctx, valid until the next cj_parse_ctx_reset. Returns
+ * NULL if the arena can not grow.
+ */
+void* cj_parse_ctx_alloc(struct cj_parse_ctx* ctx, size_t size);
+
+/**
+ * Like cj_span_dup but the string is allocated from the arena of ctx. Returns NULL if the arena can not grow.
+ */
+char* cj_parse_ctx_dup(struct cj_parse_ctx* ctx, struct cj_span* span);
+
+/**
+ * Like cj_decode_flags but the tree and its strings are allocated from the arena of ctx. The tree is not freed with
+ * cj_entity_free, it stays valid until the next cj_parse_ctx_reset.
+ */
+struct cj_entity* cj_decode_ctx(struct cj_parse_ctx* ctx, const char* b, size_t length, unsigned int flags,
+                                struct cj_error* error);
+
 struct cj_encoder_str_list {
     const char* str;
     struct cj_encoder_str_list* prev;
@@ -335,6 +596,8 @@ void cj_encoder_push_string(struct cj_encoder* encoder, const char* value);
 
 /**
  * Push a numeric value to the encoder. This function converts ints using %d. Floats are converted using %g with the default precision of 6 (%.6g), if this is not what is needed the user is welcome to convert the float themself and pushing it to the encoder via cj_encoder_put_value.
+ * 64 bit integers are written in full, doubles with the fewest digits which parse back to the same value. Whole floats
+ * and doubles get a ".0" suffix so they decode as decimals again, NaN and infinities are written as null.
  */
 void cj_encoder_push_numeric(struct cj_encoder* encoder, struct cj_numeric value);
 
@@ -344,11 +607,30 @@ void cj_encoder_push_numeric(struct cj_encoder* encoder, struct cj_numeric value
 void cj_encoder_push_integer(struct cj_encoder* encoder, int value);
 
 /**
- * Push a decimal value to the encoder. This function converts a float using %g with the default precision of 6 (%.6g),
- * if this is not what is needed the user is welcome to convert the float themself and pushing it to the encoder via
+ * Push a decimal value to the encoder. This function converts a float using %g with the default precision of 6 (%.6g)
+ * and appends ".0" if that has no '.' or exponent (2.0f is written as 2.0), NaN and infinities are written as null. If
+ * this is not what is needed the user is welcome to convert the float themself and pushing it to the encoder via
  * cj_encoder_put_value.
  */
 void cj_encoder_push_decimal(struct cj_encoder* encoder, float value);
+
+/**
+ * Push a 64 bit integer value to the encoder.
+ */
+void cj_encoder_push_integer64(struct cj_encoder* encoder, int64_t value);
+
+/**
+ * Push a 64 bit unsigned integer value to the encoder.
+ */
+void cj_encoder_push_uinteger64(struct cj_encoder* encoder, uint64_t value);
+
+/**
+ * Push a double value to the encoder. The value is written with the fewest digits (at most 17) which parse back to the
+ * same double, with a ".0" suffix if that has no '.' or exponent (1.0 is written as 1.0). NaN and infinities are
+ * written as null.
+ */
+void cj_encoder_push_decimal64(struct cj_encoder* encoder, double value);
+
 /**
  * Push a boolean value into the encoder.
  */
@@ -405,16 +687,216 @@ bool cj_span_eq(struct cj_span* s, char* cmp_str);
 void cj_span_cpy(struct cj_span* s, char* buffer, size_t n);
 
 /**
- * Decodes the span to a newly allocated string (needs to be freed with free).
+ * Decodes the span to buffer in a single pass and returns the decoded length. buffer must hold at least s->length - 1
+ * bytes, a decoded string is never longer than its escaped form.
+ */
+size_t cj_span_unescape(struct cj_span* s, char* buffer);
+
+/**
+ * Decodes the span to a newly allocated string (needs to be freed with free). Returns NULL if the allocation fails.
  */
 char* cj_span_dup(struct cj_span* s);
 
+/**
+ * Decodes the span in place and terminates it with '\0'. Afterwards s points to the decoded string and has
+ * cj_span_info_decoded set. The memory of the span must be writable.
+ */
+void cj_span_unescape_insitu(struct cj_span* s);
+
+/**
+ * A slot of the cj_key_matcher hash table, index is the key index + 1 and 0 for empty slots.
+ */
+struct cj_key_matcher_slot {
+    uint32_t hash;
+    uint32_t index;
+};
+
+/**
+ * Maps a fixed list of keys to their index with one hash probe, a faster replacement for chains of cj_span_eq calls
+ * in open and set callbacks. Build it once with cj_key_matcher_init and release it with cj_key_matcher_free.
+ *
+ * The table is perfect (collision free) if displace is not NULL: the slot of a key is found with one multiply-shift of
+ * its hash and a displacement per bucket of keys, a key is then checked with a single compare. Otherwise it falls back
+ * to linear probing.
+ */
+struct cj_key_matcher {
+    const char* const* keys;
+    size_t* lengths;
+    struct cj_key_matcher_slot* slots;
+    size_t mask;
+    size_t count;
+    size_t max_length;
+    uint32_t* displace;
+    unsigned int shift;
+    unsigned int bucket_shift;
+};
+
+/**
+ * Build a matcher for count '\0' terminated keys. The keys are not copied and must stay valid as long as the matcher.
+ * Returns cj_error_none or cj_error_out_of_memory.
+ */
+enum cj_error_code cj_key_matcher_init(struct cj_key_matcher* m, const char* const* keys, size_t count);
+
+/**
+ * Return the index of the key equal to the decoded span or -1 if there is none. If keys contains the same key twice
+ * the first index is returned.
+ */
+int cj_key_matcher_find(const struct cj_key_matcher* m, struct cj_span* id);
+
+/**
+ * Free the memory allocated by cj_key_matcher_init.
+ */
+void cj_key_matcher_free(struct cj_key_matcher* m);
+
+/**
+ * The C type a cj_field is written to.
+ */
+enum cj_field_type {
+    cj_field_bool,
+    /**
+     * int, the number has to be an integer in the range of int.
+     */
+    cj_field_int,
+    /**
+     * int64_t, the number has to be an integer in the range of int64_t.
+     */
+    cj_field_int64,
+    /**
+     * uint64_t, the number has to be a positive integer in the range of uint64_t.
+     */
+    cj_field_uint64,
+    /**
+     * double, integers are converted.
+     */
+    cj_field_double,
+    /**
+     * char*, the decoded string is allocated with malloc.
+     */
+    cj_field_string,
+    /**
+     * char[size], the decoded string is truncated to fit and always '\0' terminated.
+     */
+    cj_field_chars,
+    /**
+     * A nested struct described by binding.
+     */
+    cj_field_object,
+    /**
+     * An array of capacity elements of size bytes each, described by element. The number of parsed elements is stored
+     * in the size_t at count_offset.
+     */
+    cj_field_array,
+};
+
+struct cj_binding;
+
+/**
+ * Describes where the value of a key is stored, offset (and count_offset) are relative to the start of the struct, use
+ * offsetof. Unused members are 0.
+ */
+struct cj_field {
+    const char* key;
+    enum cj_field_type type;
+    size_t offset;
+    size_t size;
+    size_t capacity;
+    size_t count_offset;
+    /**
+     * The elements of a cj_field_array, their key is ignored and their offset is relative to each element.
+     */
+    const struct cj_field* element;
+    const struct cj_binding* binding;
+};
+
+/**
+ * A list of fields bound to the members of a struct, build it once with cj_binding_init. Nested bindings are
+ * initialized on their own.
+ */
+struct cj_binding {
+    const struct cj_field* fields;
+    size_t count;
+    const char** keys;
+    struct cj_key_matcher matcher;
+};
+
+/**
+ * Initialize binding for count fields. The fields are not copied and must stay valid as long as the binding. Returns
+ * cj_error_none, cj_error_invalid_field if a cj_field_chars (also as array element) has size 0 or
+ * cj_error_out_of_memory.
+ */
+enum cj_error_code cj_binding_init(struct cj_binding* binding, const struct cj_field* fields, size_t count);
+
+/**
+ * Free the memory allocated by cj_binding_init.
+ */
+void cj_binding_free(struct cj_binding* binding);
+
+/**
+ * Parse the first length bytes of b as a json object directly into the struct out described by binding, no callbacks
+ * are involved. Keys without a field are validated and skipped, null leaves a field unchanged and if a key repeats the
+ * last value wins. out should be zero initialized, strings are only freed by cj_bound_free. Values of the wrong type
+ * fail with cj_error_type_mismatch, arrays with too many items with cj_error_array_capacity.
+ */
+struct cj_error cj_parse_bound(const struct cj_binding* binding, const char* b, size_t length, void* out);
+
+/**
+ * Free all strings (cj_field_string) of a struct filled by cj_parse_bound, including nested structs and arrays.
+ */
+void cj_bound_free(const struct cj_binding* binding, void* out);
+
+/**
+ * The C type of the elements of a cj_number_array.
+ */
+enum cj_number_array_type {
+    /**
+     * int64_t, every number has to be an integer in the range of int64_t.
+     */
+    cj_number_array_int64,
+    /**
+     * double, integers are converted.
+     */
+    cj_number_array_double,
+};
+
+/**
+ * A caller provided buffer for the numbers of a json array, values points to capacity elements of type. count is set to
+ * the number of parsed elements.
+ */
+struct cj_number_array {
+    enum cj_number_array_type type;
+    void* values;
+    size_t capacity;
+    size_t count;
+};
+
+/**
+ * Parse the first length bytes of b as a json array of numbers straight into array, without a cj_value or a callback
+ * per element. Other values fail with cj_error_type_mismatch, more than capacity numbers with cj_error_array_capacity.
+ */
+struct cj_error cj_parse_number_array_into(const char* b, size_t length, struct cj_number_array* array);
+
 #if defined(IMPL_CJ) || defined(_CLANGD)
 #include <assert.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/*
+ * SIMD kernels are picked at compile time. SSE2 is part of the x86_64 baseline, AVX2 is used when compiling with
+ * -mavx2 (or -march=native). Define CJ_NO_SIMD to force the portable scalar code.
+ */
+#if !defined(CJ_NO_SIMD) && defined(__SSE2__)
+#define CJ_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#if !defined(CJ_NO_SIMD) && defined(__AVX2__)
+#define CJ_SIMD_AVX2
+#include <immintrin.h>
+#endif
+
 #define CJ_ERROR_BUBBLE(...)                \
     {                                       \
         enum cj_error_code e = __VA_ARGS__; \
@@ -434,18 +916,34 @@ struct cj_numeric cj_numeric_decimal(float v) {
     struct cj_numeric r = {.type = cj_numeric_type_decimal, .decimal = v};
     return r;
 }
-enum cj_error_code cj_bytes_available(char** buffer, size_t num);
+
+struct cj_numeric cj_numeric_integer64(int64_t v) {
+    struct cj_numeric r = {.type = cj_numeric_type_integer64, .integer64 = v};
+    return r;
+}
+
+struct cj_numeric cj_numeric_uinteger64(uint64_t v) {
+    struct cj_numeric r = {.type = cj_numeric_type_uinteger64, .uinteger64 = v};
+    return r;
+}
+
+struct cj_numeric cj_numeric_decimal64(double v) {
+    struct cj_numeric r = {.type = cj_numeric_type_decimal64, .decimal64 = v};
+    return r;
+}
+enum cj_error_code cj_bytes_available(char** buffer, char* end, size_t num);
 
 enum cj_error_code cj_parse_object(struct cj_parser* parser, void* parent, unsigned int parent_type, char** b,
-                                   struct cj_value* value);
+                                   char* end, struct cj_value* value);
 enum cj_error_code cj_parse_array(struct cj_parser* parser, void* parent, unsigned int parent_type, char** b,
-                                  struct cj_value* value);
-enum cj_error_code cj_parse_id(char** b, struct cj_span* id);
-enum cj_error_code cj_parse_primitive(char** b, struct cj_value* value);
-enum cj_error_code cj_parse_number(char** b, struct cj_value* value);
-enum cj_error_code cj_parse_string(char** b, struct cj_value* value);
-enum cj_error_code cj_parse_bool(char** b, struct cj_value* value);
-enum cj_error_code cj_parse_null(char** b, struct cj_value* value);
+                                  char* end, struct cj_value* value);
+enum cj_error_code cj_parse_id(char** b, char* end, unsigned int flags, struct cj_span* id);
+enum cj_error_code cj_parse_primitive(char** b, char* end, unsigned int flags, struct cj_value* value);
+enum cj_error_code cj_parse_number(char** b, char* end, struct cj_value* value);
+enum cj_error_code cj_parse_number_span(char** b, char* end, struct cj_value* value);
+enum cj_error_code cj_parse_string(char** b, char* end, struct cj_value* value);
+enum cj_error_code cj_parse_bool(char** b, char* end, struct cj_value* value);
+enum cj_error_code cj_parse_null(char** b, char* end, struct cj_value* value);
 
 enum cj_error_code cj_parse_consume_optional_white_space(char** buffer);
 enum cj_error_code cj_parse_consume(char** buffer, char character, bool optional);
@@ -455,86 +953,98 @@ enum cj_error_code cj_parse_peek_type(char** b, enum cj_type* next);
 struct cj_error cj_error_new(enum cj_error_code type, char* data, char* stopped_at) {
     struct cj_error e = {.type = type, .data = data, .stopped_at = stopped_at, .line = 0, .column = 0};
 
-    char* ptr = data;
-    while (ptr++ != stopped_at) {
-        e.column++;
+    // stopped_at may point one past the end of the input and is therefore never dereferenced
+    for (char* ptr = data; ptr < stopped_at; ptr++) {
         if (*ptr == '\n') {
             e.line++;
             e.column = 0;
+        } else {
+            e.column++;
         }
     }
     return e;
 }
 
-enum cj_error_code cj_bytes_available(char** b, size_t num) {
-    char* data = *b;
-    for (size_t i = 0; i < num; i++) {
-        if (data[i] == '\0') {
-            return cj_error_unexpected_eof;
-        }
+enum cj_error_code cj_bytes_available(char** b, char* end, size_t num) {
+    if ((size_t)(end - *b) < num) {
+        return cj_error_unexpected_eof;
     }
     return cj_error_none;
 }
 
+/**
+ * Return the character at the cursor or '\0' if the cursor reached the end of the input. This lets the parser treat
+ * the end of a length bounded buffer exactly like the terminator of a '\0' terminated string.
+ */
+#define CJ_PEEK(b, end) (*(b) < (end) ? **(b) : '\0')
+
+// Character classes
+//
+// Every byte maps to one entry of cj_char_class. The low four bits hold the value of a hexadecimal digit, the flags
+// below classify the byte and the high four bits hold the cj_type + 1 of a value starting with this byte (0 if no
+// value can start with it).
+
+#define CJ_CC_HEX_VALUE 0x000F
+#define CJ_CC_HEX 0x0010
+#define CJ_CC_DIGIT 0x0020
+#define CJ_CC_WS 0x0040
+#define CJ_CC_ESCAPE 0x0080  // may follow a backslash in a string
+#define CJ_CC_TYPE_SHIFT 12
+#define CJ_CC_TYPE(t) ((uint16_t)(((t) + 1) << CJ_CC_TYPE_SHIFT))
+
+#define CJ_CC_DEC(n) (CJ_CC_HEX | CJ_CC_DIGIT | CJ_CC_TYPE(cj_type_number) | (n))
+
+const uint16_t cj_char_class[256] = {
+    ['\t'] = CJ_CC_WS,
+    ['\n'] = CJ_CC_WS,
+    ['\r'] = CJ_CC_WS,
+    [' '] = CJ_CC_WS,
+    ['"'] = CJ_CC_ESCAPE | CJ_CC_TYPE(cj_type_string),
+    ['{'] = CJ_CC_TYPE(cj_type_object),
+    ['['] = CJ_CC_TYPE(cj_type_array),
+    ['/'] = CJ_CC_ESCAPE,
+    ['\\'] = CJ_CC_ESCAPE,
+    ['-'] = CJ_CC_TYPE(cj_type_number),
+    ['0'] = CJ_CC_DEC(0),
+    ['1'] = CJ_CC_DEC(1),
+    ['2'] = CJ_CC_DEC(2),
+    ['3'] = CJ_CC_DEC(3),
+    ['4'] = CJ_CC_DEC(4),
+    ['5'] = CJ_CC_DEC(5),
+    ['6'] = CJ_CC_DEC(6),
+    ['7'] = CJ_CC_DEC(7),
+    ['8'] = CJ_CC_DEC(8),
+    ['9'] = CJ_CC_DEC(9),
+    ['A'] = CJ_CC_HEX | 10,
+    ['B'] = CJ_CC_HEX | 11,
+    ['C'] = CJ_CC_HEX | 12,
+    ['D'] = CJ_CC_HEX | 13,
+    ['E'] = CJ_CC_HEX | 14,
+    ['F'] = CJ_CC_HEX | 15,
+    ['a'] = CJ_CC_HEX | 10,
+    ['b'] = CJ_CC_HEX | CJ_CC_ESCAPE | 11,
+    ['c'] = CJ_CC_HEX | 12,
+    ['d'] = CJ_CC_HEX | 13,
+    ['e'] = CJ_CC_HEX | 14,
+    ['f'] = CJ_CC_HEX | CJ_CC_ESCAPE | CJ_CC_TYPE(cj_type_bool) | 15,
+    ['n'] = CJ_CC_ESCAPE | CJ_CC_TYPE(cj_type_null),
+    ['r'] = CJ_CC_ESCAPE,
+    ['t'] = CJ_CC_ESCAPE | CJ_CC_TYPE(cj_type_bool),
+};
+
+#undef CJ_CC_DEC
+#undef CJ_CC_WS_
+
+#define CJ_CC(c) (cj_char_class[(unsigned char)(c)])
+#define CJ_IS_WS(c) (CJ_CC(c) & CJ_CC_WS)
+#define CJ_IS_DIGIT(c) (CJ_CC(c) & CJ_CC_DIGIT)
+
 bool cju_hex_to_uchar(char c, unsigned char* v) {
-    switch (c) {
-        case '0':
-            *v = 0;
-            break;
-        case '1':
-            *v = 1;
-            break;
-        case '2':
-            *v = 2;
-            break;
-        case '3':
-            *v = 3;
-            break;
-        case '4':
-            *v = 4;
-            break;
-        case '5':
-            *v = 5;
-            break;
-        case '6':
-            *v = 6;
-            break;
-        case '7':
-            *v = 7;
-            break;
-        case '8':
-            *v = 8;
-            break;
-        case '9':
-            *v = 9;
-            break;
-        case 'a':
-        case 'A':
-            *v = 10;
-            break;
-        case 'b':
-        case 'B':
-            *v = 11;
-            break;
-        case 'c':
-        case 'C':
-            *v = 12;
-            break;
-        case 'd':
-        case 'D':
-            *v = 13;
-            break;
-        case 'e':
-        case 'E':
-            *v = 14;
-            break;
-        case 'f':
-        case 'F':
-            *v = 15;
-            break;
-        default:
-            return false;
+    uint16_t cc = CJ_CC(c);
+    if (!(cc & CJ_CC_HEX)) {
+        return false;
     }
+    *v = cc & CJ_CC_HEX_VALUE;
     return true;
 }
 
@@ -566,10 +1076,10 @@ size_t cju_code_point_utf8_length(unsigned int x) {
     if (x <= 0x07FF) {
         return 2;
     }
-    if (x < 0xD800) {
+    if (x <= 0xFFFF) {
         return 3;
     }
-    if (x < 0x10FFFF) {
+    if (x <= 0x10FFFF) {
         return 4;
     }
     return 0;
@@ -581,7 +1091,7 @@ void cju_code_point_to_utf8(unsigned int c, char buffer[4], unsigned char len) {
     } else if (len == 1) {
         buffer[0] = c;
     } else if (len == 2) {
-        buffer[0] = 0b11000000 | (c >> 11);
+        buffer[0] = 0b11000000 | (c >> 6);
         buffer[1] = 0b10000000 | (c & 0b00111111);
     } else if (len == 3) {
         buffer[0] = 0b11100000 | (c >> 12);
@@ -595,11 +1105,11 @@ void cju_code_point_to_utf8(unsigned int c, char buffer[4], unsigned char len) {
     }
 }
 
-bool cju_parse_unicode(char* str, unsigned int* value, size_t* hex_length) {
+bool cju_parse_unicode(char* str, size_t str_len, unsigned int* value, size_t* hex_length) {
     *value = 0;
 
     // parse first hexadecimal escape sequence
-    if (strlen(str) < 6) {
+    if (str_len < 6) {
         return false;
     }
 
@@ -612,8 +1122,11 @@ bool cju_parse_unicode(char* str, unsigned int* value, size_t* hex_length) {
         return false;
     }
 
-    size_t len = cju_code_point_utf8_length(*value);
-    if (len < 4) {
+    // a low surrogate is only valid after a high surrogate
+    if (*value >= 0xDC00 && *value <= 0xDFFF) {
+        return false;
+    }
+    if (*value < 0xD800 || *value > 0xDBFF) {
         *hex_length = 6;
         return true;
     }
@@ -621,11 +1134,7 @@ bool cju_parse_unicode(char* str, unsigned int* value, size_t* hex_length) {
     // surrogate pair expected
     unsigned int high = *value;
 
-    if (high < 0xD800 || high > 0xDBFF) {
-        return false;
-    }
-
-    if (strlen(str) < 12) {
+    if (str_len < 12) {
         return false;
     }
 
@@ -649,46 +1158,779 @@ bool cju_parse_unicode(char* str, unsigned int* value, size_t* hex_length) {
     return true;
 }
 
-enum cj_error_code cj_open_void(enum cj_container_type type, void* parent, unsigned int parent_tag, union cj_key* key,
-                                void** open, unsigned int* tag) {
-    (void)type;
-    (void)parent;
-    (void)parent_tag;
-    (void)key;
-    (void)open;
-    (void)tag;
-    return cj_error_none;
+/**
+ * SWAR digit helpers, eight ASCII characters are loaded into a uint64_t with the first character in the lowest byte.
+ * Disabled together with the SIMD kernels by CJ_NO_SIMD.
+ */
+#if !defined(CJ_NO_SIMD)
+#define CJ_SWAR_DIGITS
+#endif
+
+uint64_t cju_load_8(const char* p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    v = __builtin_bswap64(v);
+#endif
+    return v;
 }
 
-enum cj_error_code cj_push_void(void* this, unsigned int tag, size_t index, struct cj_value* value) {
-    (void)this;
-    (void)tag;
-    (void)index;
-    (void)value;
-    return cj_error_none;
+/**
+ * True if all eight characters are '0' to '9'. The high nibble of every byte must be 3 and adding 6 to the low nibble
+ * must not carry into it.
+ */
+bool cju_is_8_digits(uint64_t v) {
+    return ((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) ==
+           0x3333333333333333ULL;
 }
 
-enum cj_error_code cj_set_void(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
-    (void)this;
-    (void)tag;
-    (void)id;
-    (void)value;
-    return cj_error_none;
+/**
+ * Convert eight digits to their value by combining neighbouring digits, pairs and quads with three multiplications.
+ */
+uint32_t cju_parse_8_digits(uint64_t v) {
+    v -= 0x3030303030303030ULL;
+    v = v * 10 + (v >> 8);
+    v = ((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32)) +
+         ((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))) >>
+        32;
+    return (uint32_t)v;
 }
 
-enum cj_error_code cj_span_validate(struct cj_span* s) {
-    char* str = s->ptr + 1;
-    size_t str_len = s->length - 2;
+/**
+ * Decimal to double conversion. Numbers with at most 19 significant digits are converted with the Eisel-Lemire
+ * algorithm (or exactly with a single multiplication or division if both the digits and the power of ten fit into a
+ * double). If that can not decide the rounding the digits are converted by the exact but slow cju_decimal code below.
+ * Neither path depends on the locale or on libc.
+ */
+#define CJU_POW5_MIN (-342)
+#define CJU_POW5_MAX 308
 
-    if (s->length < 2 || s->ptr[0] != '"' || s->ptr[s->length - 1] != '"') {
-        return cj_error_span_not_enclosed_by_quotes;
+/**
+ * 5^q for q in CJU_POW5_MIN..CJU_POW5_MAX as 128 bits (high word first) normalized so that the top bit is set. Negative
+ * powers are rounded up, positive powers are truncated.
+ */
+const uint64_t cju_pow5_128[2 * (CJU_POW5_MAX - CJU_POW5_MIN + 1)] = {
+    0xeef453d6923bd65aULL, 0x113faa2906a13b3fULL, 0x9558b4661b6565f8ULL, 0x4ac7ca59a424c507ULL,
+    0xbaaee17fa23ebf76ULL, 0x5d79bcf00d2df649ULL, 0xe95a99df8ace6f53ULL, 0xf4d82c2c107973dcULL,
+    0x91d8a02bb6c10594ULL, 0x79071b9b8a4be869ULL, 0xb64ec836a47146f9ULL, 0x9748e2826cdee284ULL,
+    0xe3e27a444d8d98b7ULL, 0xfd1b1b2308169b25ULL, 0x8e6d8c6ab0787f72ULL, 0xfe30f0f5e50e20f7ULL,
+    0xb208ef855c969f4fULL, 0xbdbd2d335e51a935ULL, 0xde8b2b66b3bc4723ULL, 0xad2c788035e61382ULL,
+    0x8b16fb203055ac76ULL, 0x4c3bcb5021afcc31ULL, 0xaddcb9e83c6b1793ULL, 0xdf4abe242a1bbf3dULL,
+    0xd953e8624b85dd78ULL, 0xd71d6dad34a2af0dULL, 0x87d4713d6f33aa6bULL, 0x8672648c40e5ad68ULL,
+    0xa9c98d8ccb009506ULL, 0x680efdaf511f18c2ULL, 0xd43bf0effdc0ba48ULL, 0x0212bd1b2566def2ULL,
+    0x84a57695fe98746dULL, 0x014bb630f7604b57ULL, 0xa5ced43b7e3e9188ULL, 0x419ea3bd35385e2dULL,
+    0xcf42894a5dce35eaULL, 0x52064cac828675b9ULL, 0x818995ce7aa0e1b2ULL, 0x7343efebd1940993ULL,
+    0xa1ebfb4219491a1fULL, 0x1014ebe6c5f90bf8ULL, 0xca66fa129f9b60a6ULL, 0xd41a26e077774ef6ULL,
+    0xfd00b897478238d0ULL, 0x8920b098955522b4ULL, 0x9e20735e8cb16382ULL, 0x55b46e5f5d5535b0ULL,
+    0xc5a890362fddbc62ULL, 0xeb2189f734aa831dULL, 0xf712b443bbd52b7bULL, 0xa5e9ec7501d523e4ULL,
+    0x9a6bb0aa55653b2dULL, 0x47b233c92125366eULL, 0xc1069cd4eabe89f8ULL, 0x999ec0bb696e840aULL,
+    0xf148440a256e2c76ULL, 0xc00670ea43ca250dULL, 0x96cd2a865764dbcaULL, 0x380406926a5e5728ULL,
+    0xbc807527ed3e12bcULL, 0xc605083704f5ecf2ULL, 0xeba09271e88d976bULL, 0xf7864a44c633682eULL,
+    0x93445b8731587ea3ULL, 0x7ab3ee6afbe0211dULL, 0xb8157268fdae9e4cULL, 0x5960ea05bad82964ULL,
+    0xe61acf033d1a45dfULL, 0x6fb92487298e33bdULL, 0x8fd0c16206306babULL, 0xa5d3b6d479f8e056ULL,
+    0xb3c4f1ba87bc8696ULL, 0x8f48a4899877186cULL, 0xe0b62e2929aba83cULL, 0x331acdabfe94de87ULL,
+    0x8c71dcd9ba0b4925ULL, 0x9ff0c08b7f1d0b14ULL, 0xaf8e5410288e1b6fULL, 0x07ecf0ae5ee44dd9ULL,
+    0xdb71e91432b1a24aULL, 0xc9e82cd9f69d6150ULL, 0x892731ac9faf056eULL, 0xbe311c083a225cd2ULL,
+    0xab70fe17c79ac6caULL, 0x6dbd630a48aaf406ULL, 0xd64d3d9db981787dULL, 0x092cbbccdad5b108ULL,
+    0x85f0468293f0eb4eULL, 0x25bbf56008c58ea5ULL, 0xa76c582338ed2621ULL, 0xaf2af2b80af6f24eULL,
+    0xd1476e2c07286faaULL, 0x1af5af660db4aee1ULL, 0x82cca4db847945caULL, 0x50d98d9fc890ed4dULL,
+    0xa37fce126597973cULL, 0xe50ff107bab528a0ULL, 0xcc5fc196fefd7d0cULL, 0x1e53ed49a96272c8ULL,
+    0xff77b1fcbebcdc4fULL, 0x25e8e89c13bb0f7aULL, 0x9faacf3df73609b1ULL, 0x77b191618c54e9acULL,
+    0xc795830d75038c1dULL, 0xd59df5b9ef6a2417ULL, 0xf97ae3d0d2446f25ULL, 0x4b0573286b44ad1dULL,
+    0x9becce62836ac577ULL, 0x4ee367f9430aec32ULL, 0xc2e801fb244576d5ULL, 0x229c41f793cda73fULL,
+    0xf3a20279ed56d48aULL, 0x6b43527578c1110fULL, 0x9845418c345644d6ULL, 0x830a13896b78aaa9ULL,
+    0xbe5691ef416bd60cULL, 0x23cc986bc656d553ULL, 0xedec366b11c6cb8fULL, 0x2cbfbe86b7ec8aa8ULL,
+    0x94b3a202eb1c3f39ULL, 0x7bf7d71432f3d6a9ULL, 0xb9e08a83a5e34f07ULL, 0xdaf5ccd93fb0cc53ULL,
+    0xe858ad248f5c22c9ULL, 0xd1b3400f8f9cff68ULL, 0x91376c36d99995beULL, 0x23100809b9c21fa1ULL,
+    0xb58547448ffffb2dULL, 0xabd40a0c2832a78aULL, 0xe2e69915b3fff9f9ULL, 0x16c90c8f323f516cULL,
+    0x8dd01fad907ffc3bULL, 0xae3da7d97f6792e3ULL, 0xb1442798f49ffb4aULL, 0x99cd11cfdf41779cULL,
+    0xdd95317f31c7fa1dULL, 0x40405643d711d583ULL, 0x8a7d3eef7f1cfc52ULL, 0x482835ea666b2572ULL,
+    0xad1c8eab5ee43b66ULL, 0xda3243650005eecfULL, 0xd863b256369d4a40ULL, 0x90bed43e40076a82ULL,
+    0x873e4f75e2224e68ULL, 0x5a7744a6e804a291ULL, 0xa90de3535aaae202ULL, 0x711515d0a205cb36ULL,
+    0xd3515c2831559a83ULL, 0x0d5a5b44ca873e03ULL, 0x8412d9991ed58091ULL, 0xe858790afe9486c2ULL,
+    0xa5178fff668ae0b6ULL, 0x626e974dbe39a872ULL, 0xce5d73ff402d98e3ULL, 0xfb0a3d212dc8128fULL,
+    0x80fa687f881c7f8eULL, 0x7ce66634bc9d0b99ULL, 0xa139029f6a239f72ULL, 0x1c1fffc1ebc44e80ULL,
+    0xc987434744ac874eULL, 0xa327ffb266b56220ULL, 0xfbe9141915d7a922ULL, 0x4bf1ff9f0062baa8ULL,
+    0x9d71ac8fada6c9b5ULL, 0x6f773fc3603db4a9ULL, 0xc4ce17b399107c22ULL, 0xcb550fb4384d21d3ULL,
+    0xf6019da07f549b2bULL, 0x7e2a53a146606a48ULL, 0x99c102844f94e0fbULL, 0x2eda7444cbfc426dULL,
+    0xc0314325637a1939ULL, 0xfa911155fefb5308ULL, 0xf03d93eebc589f88ULL, 0x793555ab7eba27caULL,
+    0x96267c7535b763b5ULL, 0x4bc1558b2f3458deULL, 0xbbb01b9283253ca2ULL, 0x9eb1aaedfb016f16ULL,
+    0xea9c227723ee8bcbULL, 0x465e15a979c1cadcULL, 0x92a1958a7675175fULL, 0x0bfacd89ec191ec9ULL,
+    0xb749faed14125d36ULL, 0xcef980ec671f667bULL, 0xe51c79a85916f484ULL, 0x82b7e12780e7401aULL,
+    0x8f31cc0937ae58d2ULL, 0xd1b2ecb8b0908810ULL, 0xb2fe3f0b8599ef07ULL, 0x861fa7e6dcb4aa15ULL,
+    0xdfbdcece67006ac9ULL, 0x67a791e093e1d49aULL, 0x8bd6a141006042bdULL, 0xe0c8bb2c5c6d24e0ULL,
+    0xaecc49914078536dULL, 0x58fae9f773886e18ULL, 0xda7f5bf590966848ULL, 0xaf39a475506a899eULL,
+    0x888f99797a5e012dULL, 0x6d8406c952429603ULL, 0xaab37fd7d8f58178ULL, 0xc8e5087ba6d33b83ULL,
+    0xd5605fcdcf32e1d6ULL, 0xfb1e4a9a90880a64ULL, 0x855c3be0a17fcd26ULL, 0x5cf2eea09a55067fULL,
+    0xa6b34ad8c9dfc06fULL, 0xf42faa48c0ea481eULL, 0xd0601d8efc57b08bULL, 0xf13b94daf124da26ULL,
+    0x823c12795db6ce57ULL, 0x76c53d08d6b70858ULL, 0xa2cb1717b52481edULL, 0x54768c4b0c64ca6eULL,
+    0xcb7ddcdda26da268ULL, 0xa9942f5dcf7dfd09ULL, 0xfe5d54150b090b02ULL, 0xd3f93b35435d7c4cULL,
+    0x9efa548d26e5a6e1ULL, 0xc47bc5014a1a6dafULL, 0xc6b8e9b0709f109aULL, 0x359ab6419ca1091bULL,
+    0xf867241c8cc6d4c0ULL, 0xc30163d203c94b62ULL, 0x9b407691d7fc44f8ULL, 0x79e0de63425dcf1dULL,
+    0xc21094364dfb5636ULL, 0x985915fc12f542e4ULL, 0xf294b943e17a2bc4ULL, 0x3e6f5b7b17b2939dULL,
+    0x979cf3ca6cec5b5aULL, 0xa705992ceecf9c42ULL, 0xbd8430bd08277231ULL, 0x50c6ff782a838353ULL,
+    0xece53cec4a314ebdULL, 0xa4f8bf5635246428ULL, 0x940f4613ae5ed136ULL, 0x871b7795e136be99ULL,
+    0xb913179899f68584ULL, 0x28e2557b59846e3fULL, 0xe757dd7ec07426e5ULL, 0x331aeada2fe589cfULL,
+    0x9096ea6f3848984fULL, 0x3ff0d2c85def7621ULL, 0xb4bca50b065abe63ULL, 0x0fed077a756b53a9ULL,
+    0xe1ebce4dc7f16dfbULL, 0xd3e8495912c62894ULL, 0x8d3360f09cf6e4bdULL, 0x64712dd7abbbd95cULL,
+    0xb080392cc4349decULL, 0xbd8d794d96aacfb3ULL, 0xdca04777f541c567ULL, 0xecf0d7a0fc5583a0ULL,
+    0x89e42caaf9491b60ULL, 0xf41686c49db57244ULL, 0xac5d37d5b79b6239ULL, 0x311c2875c522ced5ULL,
+    0xd77485cb25823ac7ULL, 0x7d633293366b828bULL, 0x86a8d39ef77164bcULL, 0xae5dff9c02033197ULL,
+    0xa8530886b54dbdebULL, 0xd9f57f830283fdfcULL, 0xd267caa862a12d66ULL, 0xd072df63c324fd7bULL,
+    0x8380dea93da4bc60ULL, 0x4247cb9e59f71e6dULL, 0xa46116538d0deb78ULL, 0x52d9be85f074e608ULL,
+    0xcd795be870516656ULL, 0x67902e276c921f8bULL, 0x806bd9714632dff6ULL, 0x00ba1cd8a3db53b6ULL,
+    0xa086cfcd97bf97f3ULL, 0x80e8a40eccd228a4ULL, 0xc8a883c0fdaf7df0ULL, 0x6122cd128006b2cdULL,
+    0xfad2a4b13d1b5d6cULL, 0x796b805720085f81ULL, 0x9cc3a6eec6311a63ULL, 0xcbe3303674053bb0ULL,
+    0xc3f490aa77bd60fcULL, 0xbedbfc4411068a9cULL, 0xf4f1b4d515acb93bULL, 0xee92fb5515482d44ULL,
+    0x991711052d8bf3c5ULL, 0x751bdd152d4d1c4aULL, 0xbf5cd54678eef0b6ULL, 0xd262d45a78a0635dULL,
+    0xef340a98172aace4ULL, 0x86fb897116c87c34ULL, 0x9580869f0e7aac0eULL, 0xd45d35e6ae3d4da0ULL,
+    0xbae0a846d2195712ULL, 0x8974836059cca109ULL, 0xe998d258869facd7ULL, 0x2bd1a438703fc94bULL,
+    0x91ff83775423cc06ULL, 0x7b6306a34627ddcfULL, 0xb67f6455292cbf08ULL, 0x1a3bc84c17b1d542ULL,
+    0xe41f3d6a7377eecaULL, 0x20caba5f1d9e4a93ULL, 0x8e938662882af53eULL, 0x547eb47b7282ee9cULL,
+    0xb23867fb2a35b28dULL, 0xe99e619a4f23aa43ULL, 0xdec681f9f4c31f31ULL, 0x6405fa00e2ec94d4ULL,
+    0x8b3c113c38f9f37eULL, 0xde83bc408dd3dd04ULL, 0xae0b158b4738705eULL, 0x9624ab50b148d445ULL,
+    0xd98ddaee19068c76ULL, 0x3badd624dd9b0957ULL, 0x87f8a8d4cfa417c9ULL, 0xe54ca5d70a80e5d6ULL,
+    0xa9f6d30a038d1dbcULL, 0x5e9fcf4ccd211f4cULL, 0xd47487cc8470652bULL, 0x7647c3200069671fULL,
+    0x84c8d4dfd2c63f3bULL, 0x29ecd9f40041e073ULL, 0xa5fb0a17c777cf09ULL, 0xf468107100525890ULL,
+    0xcf79cc9db955c2ccULL, 0x7182148d4066eeb4ULL, 0x81ac1fe293d599bfULL, 0xc6f14cd848405530ULL,
+    0xa21727db38cb002fULL, 0xb8ada00e5a506a7cULL, 0xca9cf1d206fdc03bULL, 0xa6d90811f0e4851cULL,
+    0xfd442e4688bd304aULL, 0x908f4a166d1da663ULL, 0x9e4a9cec15763e2eULL, 0x9a598e4e043287feULL,
+    0xc5dd44271ad3cdbaULL, 0x40eff1e1853f29fdULL, 0xf7549530e188c128ULL, 0xd12bee59e68ef47cULL,
+    0x9a94dd3e8cf578b9ULL, 0x82bb74f8301958ceULL, 0xc13a148e3032d6e7ULL, 0xe36a52363c1faf01ULL,
+    0xf18899b1bc3f8ca1ULL, 0xdc44e6c3cb279ac1ULL, 0x96f5600f15a7b7e5ULL, 0x29ab103a5ef8c0b9ULL,
+    0xbcb2b812db11a5deULL, 0x7415d448f6b6f0e7ULL, 0xebdf661791d60f56ULL, 0x111b495b3464ad21ULL,
+    0x936b9fcebb25c995ULL, 0xcab10dd900beec34ULL, 0xb84687c269ef3bfbULL, 0x3d5d514f40eea742ULL,
+    0xe65829b3046b0afaULL, 0x0cb4a5a3112a5112ULL, 0x8ff71a0fe2c2e6dcULL, 0x47f0e785eaba72abULL,
+    0xb3f4e093db73a093ULL, 0x59ed216765690f56ULL, 0xe0f218b8d25088b8ULL, 0x306869c13ec3532cULL,
+    0x8c974f7383725573ULL, 0x1e414218c73a13fbULL, 0xafbd2350644eeacfULL, 0xe5d1929ef90898faULL,
+    0xdbac6c247d62a583ULL, 0xdf45f746b74abf39ULL, 0x894bc396ce5da772ULL, 0x6b8bba8c328eb783ULL,
+    0xab9eb47c81f5114fULL, 0x066ea92f3f326564ULL, 0xd686619ba27255a2ULL, 0xc80a537b0efefebdULL,
+    0x8613fd0145877585ULL, 0xbd06742ce95f5f36ULL, 0xa798fc4196e952e7ULL, 0x2c48113823b73704ULL,
+    0xd17f3b51fca3a7a0ULL, 0xf75a15862ca504c5ULL, 0x82ef85133de648c4ULL, 0x9a984d73dbe722fbULL,
+    0xa3ab66580d5fdaf5ULL, 0xc13e60d0d2e0ebbaULL, 0xcc963fee10b7d1b3ULL, 0x318df905079926a8ULL,
+    0xffbbcfe994e5c61fULL, 0xfdf17746497f7052ULL, 0x9fd561f1fd0f9bd3ULL, 0xfeb6ea8bedefa633ULL,
+    0xc7caba6e7c5382c8ULL, 0xfe64a52ee96b8fc0ULL, 0xf9bd690a1b68637bULL, 0x3dfdce7aa3c673b0ULL,
+    0x9c1661a651213e2dULL, 0x06bea10ca65c084eULL, 0xc31bfa0fe5698db8ULL, 0x486e494fcff30a62ULL,
+    0xf3e2f893dec3f126ULL, 0x5a89dba3c3efccfaULL, 0x986ddb5c6b3a76b7ULL, 0xf89629465a75e01cULL,
+    0xbe89523386091465ULL, 0xf6bbb397f1135823ULL, 0xee2ba6c0678b597fULL, 0x746aa07ded582e2cULL,
+    0x94db483840b717efULL, 0xa8c2a44eb4571cdcULL, 0xba121a4650e4ddebULL, 0x92f34d62616ce413ULL,
+    0xe896a0d7e51e1566ULL, 0x77b020baf9c81d17ULL, 0x915e2486ef32cd60ULL, 0x0ace1474dc1d122eULL,
+    0xb5b5ada8aaff80b8ULL, 0x0d819992132456baULL, 0xe3231912d5bf60e6ULL, 0x10e1fff697ed6c69ULL,
+    0x8df5efabc5979c8fULL, 0xca8d3ffa1ef463c1ULL, 0xb1736b96b6fd83b3ULL, 0xbd308ff8a6b17cb2ULL,
+    0xddd0467c64bce4a0ULL, 0xac7cb3f6d05ddbdeULL, 0x8aa22c0dbef60ee4ULL, 0x6bcdf07a423aa96bULL,
+    0xad4ab7112eb3929dULL, 0x86c16c98d2c953c6ULL, 0xd89d64d57a607744ULL, 0xe871c7bf077ba8b7ULL,
+    0x87625f056c7c4a8bULL, 0x11471cd764ad4972ULL, 0xa93af6c6c79b5d2dULL, 0xd598e40d3dd89bcfULL,
+    0xd389b47879823479ULL, 0x4aff1d108d4ec2c3ULL, 0x843610cb4bf160cbULL, 0xcedf722a585139baULL,
+    0xa54394fe1eedb8feULL, 0xc2974eb4ee658828ULL, 0xce947a3da6a9273eULL, 0x733d226229feea32ULL,
+    0x811ccc668829b887ULL, 0x0806357d5a3f525fULL, 0xa163ff802a3426a8ULL, 0xca07c2dcb0cf26f7ULL,
+    0xc9bcff6034c13052ULL, 0xfc89b393dd02f0b5ULL, 0xfc2c3f3841f17c67ULL, 0xbbac2078d443ace2ULL,
+    0x9d9ba7832936edc0ULL, 0xd54b944b84aa4c0dULL, 0xc5029163f384a931ULL, 0x0a9e795e65d4df11ULL,
+    0xf64335bcf065d37dULL, 0x4d4617b5ff4a16d5ULL, 0x99ea0196163fa42eULL, 0x504bced1bf8e4e45ULL,
+    0xc06481fb9bcf8d39ULL, 0xe45ec2862f71e1d6ULL, 0xf07da27a82c37088ULL, 0x5d767327bb4e5a4cULL,
+    0x964e858c91ba2655ULL, 0x3a6a07f8d510f86fULL, 0xbbe226efb628afeaULL, 0x890489f70a55368bULL,
+    0xeadab0aba3b2dbe5ULL, 0x2b45ac74ccea842eULL, 0x92c8ae6b464fc96fULL, 0x3b0b8bc90012929dULL,
+    0xb77ada0617e3bbcbULL, 0x09ce6ebb40173744ULL, 0xe55990879ddcaabdULL, 0xcc420a6a101d0515ULL,
+    0x8f57fa54c2a9eab6ULL, 0x9fa946824a12232dULL, 0xb32df8e9f3546564ULL, 0x47939822dc96abf9ULL,
+    0xdff9772470297ebdULL, 0x59787e2b93bc56f7ULL, 0x8bfbea76c619ef36ULL, 0x57eb4edb3c55b65aULL,
+    0xaefae51477a06b03ULL, 0xede622920b6b23f1ULL, 0xdab99e59958885c4ULL, 0xe95fab368e45ecedULL,
+    0x88b402f7fd75539bULL, 0x11dbcb0218ebb414ULL, 0xaae103b5fcd2a881ULL, 0xd652bdc29f26a119ULL,
+    0xd59944a37c0752a2ULL, 0x4be76d3346f0495fULL, 0x857fcae62d8493a5ULL, 0x6f70a4400c562ddbULL,
+    0xa6dfbd9fb8e5b88eULL, 0xcb4ccd500f6bb952ULL, 0xd097ad07a71f26b2ULL, 0x7e2000a41346a7a7ULL,
+    0x825ecc24c873782fULL, 0x8ed400668c0c28c8ULL, 0xa2f67f2dfa90563bULL, 0x728900802f0f32faULL,
+    0xcbb41ef979346bcaULL, 0x4f2b40a03ad2ffb9ULL, 0xfea126b7d78186bcULL, 0xe2f610c84987bfa8ULL,
+    0x9f24b832e6b0f436ULL, 0x0dd9ca7d2df4d7c9ULL, 0xc6ede63fa05d3143ULL, 0x91503d1c79720dbbULL,
+    0xf8a95fcf88747d94ULL, 0x75a44c6397ce912aULL, 0x9b69dbe1b548ce7cULL, 0xc986afbe3ee11abaULL,
+    0xc24452da229b021bULL, 0xfbe85badce996168ULL, 0xf2d56790ab41c2a2ULL, 0xfae27299423fb9c3ULL,
+    0x97c560ba6b0919a5ULL, 0xdccd879fc967d41aULL, 0xbdb6b8e905cb600fULL, 0x5400e987bbc1c920ULL,
+    0xed246723473e3813ULL, 0x290123e9aab23b68ULL, 0x9436c0760c86e30bULL, 0xf9a0b6720aaf6521ULL,
+    0xb94470938fa89bceULL, 0xf808e40e8d5b3e69ULL, 0xe7958cb87392c2c2ULL, 0xb60b1d1230b20e04ULL,
+    0x90bd77f3483bb9b9ULL, 0xb1c6f22b5e6f48c2ULL, 0xb4ecd5f01a4aa828ULL, 0x1e38aeb6360b1af3ULL,
+    0xe2280b6c20dd5232ULL, 0x25c6da63c38de1b0ULL, 0x8d590723948a535fULL, 0x579c487e5a38ad0eULL,
+    0xb0af48ec79ace837ULL, 0x2d835a9df0c6d851ULL, 0xdcdb1b2798182244ULL, 0xf8e431456cf88e65ULL,
+    0x8a08f0f8bf0f156bULL, 0x1b8e9ecb641b58ffULL, 0xac8b2d36eed2dac5ULL, 0xe272467e3d222f3fULL,
+    0xd7adf884aa879177ULL, 0x5b0ed81dcc6abb0fULL, 0x86ccbb52ea94baeaULL, 0x98e947129fc2b4e9ULL,
+    0xa87fea27a539e9a5ULL, 0x3f2398d747b36224ULL, 0xd29fe4b18e88640eULL, 0x8eec7f0d19a03aadULL,
+    0x83a3eeeef9153e89ULL, 0x1953cf68300424acULL, 0xa48ceaaab75a8e2bULL, 0x5fa8c3423c052dd7ULL,
+    0xcdb02555653131b6ULL, 0x3792f412cb06794dULL, 0x808e17555f3ebf11ULL, 0xe2bbd88bbee40bd0ULL,
+    0xa0b19d2ab70e6ed6ULL, 0x5b6aceaeae9d0ec4ULL, 0xc8de047564d20a8bULL, 0xf245825a5a445275ULL,
+    0xfb158592be068d2eULL, 0xeed6e2f0f0d56712ULL, 0x9ced737bb6c4183dULL, 0x55464dd69685606bULL,
+    0xc428d05aa4751e4cULL, 0xaa97e14c3c26b886ULL, 0xf53304714d9265dfULL, 0xd53dd99f4b3066a8ULL,
+    0x993fe2c6d07b7fabULL, 0xe546a8038efe4029ULL, 0xbf8fdb78849a5f96ULL, 0xde98520472bdd033ULL,
+    0xef73d256a5c0f77cULL, 0x963e66858f6d4440ULL, 0x95a8637627989aadULL, 0xdde7001379a44aa8ULL,
+    0xbb127c53b17ec159ULL, 0x5560c018580d5d52ULL, 0xe9d71b689dde71afULL, 0xaab8f01e6e10b4a6ULL,
+    0x9226712162ab070dULL, 0xcab3961304ca70e8ULL, 0xb6b00d69bb55c8d1ULL, 0x3d607b97c5fd0d22ULL,
+    0xe45c10c42a2b3b05ULL, 0x8cb89a7db77c506aULL, 0x8eb98a7a9a5b04e3ULL, 0x77f3608e92adb242ULL,
+    0xb267ed1940f1c61cULL, 0x55f038b237591ed3ULL, 0xdf01e85f912e37a3ULL, 0x6b6c46dec52f6688ULL,
+    0x8b61313bbabce2c6ULL, 0x2323ac4b3b3da015ULL, 0xae397d8aa96c1b77ULL, 0xabec975e0a0d081aULL,
+    0xd9c7dced53c72255ULL, 0x96e7bd358c904a21ULL, 0x881cea14545c7575ULL, 0x7e50d64177da2e54ULL,
+    0xaa242499697392d2ULL, 0xdde50bd1d5d0b9e9ULL, 0xd4ad2dbfc3d07787ULL, 0x955e4ec64b44e864ULL,
+    0x84ec3c97da624ab4ULL, 0xbd5af13bef0b113eULL, 0xa6274bbdd0fadd61ULL, 0xecb1ad8aeacdd58eULL,
+    0xcfb11ead453994baULL, 0x67de18eda5814af2ULL, 0x81ceb32c4b43fcf4ULL, 0x80eacf948770ced7ULL,
+    0xa2425ff75e14fc31ULL, 0xa1258379a94d028dULL, 0xcad2f7f5359a3b3eULL, 0x096ee45813a04330ULL,
+    0xfd87b5f28300ca0dULL, 0x8bca9d6e188853fcULL, 0x9e74d1b791e07e48ULL, 0x775ea264cf55347eULL,
+    0xc612062576589ddaULL, 0x95364afe032a819eULL, 0xf79687aed3eec551ULL, 0x3a83ddbd83f52205ULL,
+    0x9abe14cd44753b52ULL, 0xc4926a9672793543ULL, 0xc16d9a0095928a27ULL, 0x75b7053c0f178294ULL,
+    0xf1c90080baf72cb1ULL, 0x5324c68b12dd6339ULL, 0x971da05074da7beeULL, 0xd3f6fc16ebca5e04ULL,
+    0xbce5086492111aeaULL, 0x88f4bb1ca6bcf585ULL, 0xec1e4a7db69561a5ULL, 0x2b31e9e3d06c32e6ULL,
+    0x9392ee8e921d5d07ULL, 0x3aff322e62439fd0ULL, 0xb877aa3236a4b449ULL, 0x09befeb9fad487c3ULL,
+    0xe69594bec44de15bULL, 0x4c2ebe687989a9b4ULL, 0x901d7cf73ab0acd9ULL, 0x0f9d37014bf60a11ULL,
+    0xb424dc35095cd80fULL, 0x538484c19ef38c95ULL, 0xe12e13424bb40e13ULL, 0x2865a5f206b06fbaULL,
+    0x8cbccc096f5088cbULL, 0xf93f87b7442e45d4ULL, 0xafebff0bcb24aafeULL, 0xf78f69a51539d749ULL,
+    0xdbe6fecebdedd5beULL, 0xb573440e5a884d1cULL, 0x89705f4136b4a597ULL, 0x31680a88f8953031ULL,
+    0xabcc77118461cefcULL, 0xfdc20d2b36ba7c3eULL, 0xd6bf94d5e57a42bcULL, 0x3d32907604691b4dULL,
+    0x8637bd05af6c69b5ULL, 0xa63f9a49c2c1b110ULL, 0xa7c5ac471b478423ULL, 0x0fcf80dc33721d54ULL,
+    0xd1b71758e219652bULL, 0xd3c36113404ea4a9ULL, 0x83126e978d4fdf3bULL, 0x645a1cac083126eaULL,
+    0xa3d70a3d70a3d70aULL, 0x3d70a3d70a3d70a4ULL, 0xccccccccccccccccULL, 0xcccccccccccccccdULL,
+    0x8000000000000000ULL, 0x0000000000000000ULL, 0xa000000000000000ULL, 0x0000000000000000ULL,
+    0xc800000000000000ULL, 0x0000000000000000ULL, 0xfa00000000000000ULL, 0x0000000000000000ULL,
+    0x9c40000000000000ULL, 0x0000000000000000ULL, 0xc350000000000000ULL, 0x0000000000000000ULL,
+    0xf424000000000000ULL, 0x0000000000000000ULL, 0x9896800000000000ULL, 0x0000000000000000ULL,
+    0xbebc200000000000ULL, 0x0000000000000000ULL, 0xee6b280000000000ULL, 0x0000000000000000ULL,
+    0x9502f90000000000ULL, 0x0000000000000000ULL, 0xba43b74000000000ULL, 0x0000000000000000ULL,
+    0xe8d4a51000000000ULL, 0x0000000000000000ULL, 0x9184e72a00000000ULL, 0x0000000000000000ULL,
+    0xb5e620f480000000ULL, 0x0000000000000000ULL, 0xe35fa931a0000000ULL, 0x0000000000000000ULL,
+    0x8e1bc9bf04000000ULL, 0x0000000000000000ULL, 0xb1a2bc2ec5000000ULL, 0x0000000000000000ULL,
+    0xde0b6b3a76400000ULL, 0x0000000000000000ULL, 0x8ac7230489e80000ULL, 0x0000000000000000ULL,
+    0xad78ebc5ac620000ULL, 0x0000000000000000ULL, 0xd8d726b7177a8000ULL, 0x0000000000000000ULL,
+    0x878678326eac9000ULL, 0x0000000000000000ULL, 0xa968163f0a57b400ULL, 0x0000000000000000ULL,
+    0xd3c21bcecceda100ULL, 0x0000000000000000ULL, 0x84595161401484a0ULL, 0x0000000000000000ULL,
+    0xa56fa5b99019a5c8ULL, 0x0000000000000000ULL, 0xcecb8f27f4200f3aULL, 0x0000000000000000ULL,
+    0x813f3978f8940984ULL, 0x4000000000000000ULL, 0xa18f07d736b90be5ULL, 0x5000000000000000ULL,
+    0xc9f2c9cd04674edeULL, 0xa400000000000000ULL, 0xfc6f7c4045812296ULL, 0x4d00000000000000ULL,
+    0x9dc5ada82b70b59dULL, 0xf020000000000000ULL, 0xc5371912364ce305ULL, 0x6c28000000000000ULL,
+    0xf684df56c3e01bc6ULL, 0xc732000000000000ULL, 0x9a130b963a6c115cULL, 0x3c7f400000000000ULL,
+    0xc097ce7bc90715b3ULL, 0x4b9f100000000000ULL, 0xf0bdc21abb48db20ULL, 0x1e86d40000000000ULL,
+    0x96769950b50d88f4ULL, 0x1314448000000000ULL, 0xbc143fa4e250eb31ULL, 0x17d955a000000000ULL,
+    0xeb194f8e1ae525fdULL, 0x5dcfab0800000000ULL, 0x92efd1b8d0cf37beULL, 0x5aa1cae500000000ULL,
+    0xb7abc627050305adULL, 0xf14a3d9e40000000ULL, 0xe596b7b0c643c719ULL, 0x6d9ccd05d0000000ULL,
+    0x8f7e32ce7bea5c6fULL, 0xe4820023a2000000ULL, 0xb35dbf821ae4f38bULL, 0xdda2802c8a800000ULL,
+    0xe0352f62a19e306eULL, 0xd50b2037ad200000ULL, 0x8c213d9da502de45ULL, 0x4526f422cc340000ULL,
+    0xaf298d050e4395d6ULL, 0x9670b12b7f410000ULL, 0xdaf3f04651d47b4cULL, 0x3c0cdd765f114000ULL,
+    0x88d8762bf324cd0fULL, 0xa5880a69fb6ac800ULL, 0xab0e93b6efee0053ULL, 0x8eea0d047a457a00ULL,
+    0xd5d238a4abe98068ULL, 0x72a4904598d6d880ULL, 0x85a36366eb71f041ULL, 0x47a6da2b7f864750ULL,
+    0xa70c3c40a64e6c51ULL, 0x999090b65f67d924ULL, 0xd0cf4b50cfe20765ULL, 0xfff4b4e3f741cf6dULL,
+    0x82818f1281ed449fULL, 0xbff8f10e7a8921a4ULL, 0xa321f2d7226895c7ULL, 0xaff72d52192b6a0dULL,
+    0xcbea6f8ceb02bb39ULL, 0x9bf4f8a69f764490ULL, 0xfee50b7025c36a08ULL, 0x02f236d04753d5b4ULL,
+    0x9f4f2726179a2245ULL, 0x01d762422c946590ULL, 0xc722f0ef9d80aad6ULL, 0x424d3ad2b7b97ef5ULL,
+    0xf8ebad2b84e0d58bULL, 0xd2e0898765a7deb2ULL, 0x9b934c3b330c8577ULL, 0x63cc55f49f88eb2fULL,
+    0xc2781f49ffcfa6d5ULL, 0x3cbf6b71c76b25fbULL, 0xf316271c7fc3908aULL, 0x8bef464e3945ef7aULL,
+    0x97edd871cfda3a56ULL, 0x97758bf0e3cbb5acULL, 0xbde94e8e43d0c8ecULL, 0x3d52eeed1cbea317ULL,
+    0xed63a231d4c4fb27ULL, 0x4ca7aaa863ee4bddULL, 0x945e455f24fb1cf8ULL, 0x8fe8caa93e74ef6aULL,
+    0xb975d6b6ee39e436ULL, 0xb3e2fd538e122b44ULL, 0xe7d34c64a9c85d44ULL, 0x60dbbca87196b616ULL,
+    0x90e40fbeea1d3a4aULL, 0xbc8955e946fe31cdULL, 0xb51d13aea4a488ddULL, 0x6babab6398bdbe41ULL,
+    0xe264589a4dcdab14ULL, 0xc696963c7eed2dd1ULL, 0x8d7eb76070a08aecULL, 0xfc1e1de5cf543ca2ULL,
+    0xb0de65388cc8ada8ULL, 0x3b25a55f43294bcbULL, 0xdd15fe86affad912ULL, 0x49ef0eb713f39ebeULL,
+    0x8a2dbf142dfcc7abULL, 0x6e3569326c784337ULL, 0xacb92ed9397bf996ULL, 0x49c2c37f07965404ULL,
+    0xd7e77a8f87daf7fbULL, 0xdc33745ec97be906ULL, 0x86f0ac99b4e8dafdULL, 0x69a028bb3ded71a3ULL,
+    0xa8acd7c0222311bcULL, 0xc40832ea0d68ce0cULL, 0xd2d80db02aabd62bULL, 0xf50a3fa490c30190ULL,
+    0x83c7088e1aab65dbULL, 0x792667c6da79e0faULL, 0xa4b8cab1a1563f52ULL, 0x577001b891185938ULL,
+    0xcde6fd5e09abcf26ULL, 0xed4c0226b55e6f86ULL, 0x80b05e5ac60b6178ULL, 0x544f8158315b05b4ULL,
+    0xa0dc75f1778e39d6ULL, 0x696361ae3db1c721ULL, 0xc913936dd571c84cULL, 0x03bc3a19cd1e38e9ULL,
+    0xfb5878494ace3a5fULL, 0x04ab48a04065c723ULL, 0x9d174b2dcec0e47bULL, 0x62eb0d64283f9c76ULL,
+    0xc45d1df942711d9aULL, 0x3ba5d0bd324f8394ULL, 0xf5746577930d6500ULL, 0xca8f44ec7ee36479ULL,
+    0x9968bf6abbe85f20ULL, 0x7e998b13cf4e1ecbULL, 0xbfc2ef456ae276e8ULL, 0x9e3fedd8c321a67eULL,
+    0xefb3ab16c59b14a2ULL, 0xc5cfe94ef3ea101eULL, 0x95d04aee3b80ece5ULL, 0xbba1f1d158724a12ULL,
+    0xbb445da9ca61281fULL, 0x2a8a6e45ae8edc97ULL, 0xea1575143cf97226ULL, 0xf52d09d71a3293bdULL,
+    0x924d692ca61be758ULL, 0x593c2626705f9c56ULL, 0xb6e0c377cfa2e12eULL, 0x6f8b2fb00c77836cULL,
+    0xe498f455c38b997aULL, 0x0b6dfb9c0f956447ULL, 0x8edf98b59a373fecULL, 0x4724bd4189bd5eacULL,
+    0xb2977ee300c50fe7ULL, 0x58edec91ec2cb657ULL, 0xdf3d5e9bc0f653e1ULL, 0x2f2967b66737e3edULL,
+    0x8b865b215899f46cULL, 0xbd79e0d20082ee74ULL, 0xae67f1e9aec07187ULL, 0xecd8590680a3aa11ULL,
+    0xda01ee641a708de9ULL, 0xe80e6f4820cc9495ULL, 0x884134fe908658b2ULL, 0x3109058d147fdcddULL,
+    0xaa51823e34a7eedeULL, 0xbd4b46f0599fd415ULL, 0xd4e5e2cdc1d1ea96ULL, 0x6c9e18ac7007c91aULL,
+    0x850fadc09923329eULL, 0x03e2cf6bc604ddb0ULL, 0xa6539930bf6bff45ULL, 0x84db8346b786151cULL,
+    0xcfe87f7cef46ff16ULL, 0xe612641865679a63ULL, 0x81f14fae158c5f6eULL, 0x4fcb7e8f3f60c07eULL,
+    0xa26da3999aef7749ULL, 0xe3be5e330f38f09dULL, 0xcb090c8001ab551cULL, 0x5cadf5bfd3072cc5ULL,
+    0xfdcb4fa002162a63ULL, 0x73d9732fc7c8f7f6ULL, 0x9e9f11c4014dda7eULL, 0x2867e7fddcdd9afaULL,
+    0xc646d63501a1511dULL, 0xb281e1fd541501b8ULL, 0xf7d88bc24209a565ULL, 0x1f225a7ca91a4226ULL,
+    0x9ae757596946075fULL, 0x3375788de9b06958ULL, 0xc1a12d2fc3978937ULL, 0x0052d6b1641c83aeULL,
+    0xf209787bb47d6b84ULL, 0xc0678c5dbd23a49aULL, 0x9745eb4d50ce6332ULL, 0xf840b7ba963646e0ULL,
+    0xbd176620a501fbffULL, 0xb650e5a93bc3d898ULL, 0xec5d3fa8ce427affULL, 0xa3e51f138ab4cebeULL,
+    0x93ba47c980e98cdfULL, 0xc66f336c36b10137ULL, 0xb8a8d9bbe123f017ULL, 0xb80b0047445d4184ULL,
+    0xe6d3102ad96cec1dULL, 0xa60dc059157491e5ULL, 0x9043ea1ac7e41392ULL, 0x87c89837ad68db2fULL,
+    0xb454e4a179dd1877ULL, 0x29babe4598c311fbULL, 0xe16a1dc9d8545e94ULL, 0xf4296dd6fef3d67aULL,
+    0x8ce2529e2734bb1dULL, 0x1899e4a65f58660cULL, 0xb01ae745b101e9e4ULL, 0x5ec05dcff72e7f8fULL,
+    0xdc21a1171d42645dULL, 0x76707543f4fa1f73ULL, 0x899504ae72497ebaULL, 0x6a06494a791c53a8ULL,
+    0xabfa45da0edbde69ULL, 0x0487db9d17636892ULL, 0xd6f8d7509292d603ULL, 0x45a9d2845d3c42b6ULL,
+    0x865b86925b9bc5c2ULL, 0x0b8a2392ba45a9b2ULL, 0xa7f26836f282b732ULL, 0x8e6cac7768d7141eULL,
+    0xd1ef0244af2364ffULL, 0x3207d795430cd926ULL, 0x8335616aed761f1fULL, 0x7f44e6bd49e807b8ULL,
+    0xa402b9c5a8d3a6e7ULL, 0x5f16206c9c6209a6ULL, 0xcd036837130890a1ULL, 0x36dba887c37a8c0fULL,
+    0x802221226be55a64ULL, 0xc2494954da2c9789ULL, 0xa02aa96b06deb0fdULL, 0xf2db9baa10b7bd6cULL,
+    0xc83553c5c8965d3dULL, 0x6f92829494e5acc7ULL, 0xfa42a8b73abbf48cULL, 0xcb772339ba1f17f9ULL,
+    0x9c69a97284b578d7ULL, 0xff2a760414536efbULL, 0xc38413cf25e2d70dULL, 0xfef5138519684abaULL,
+    0xf46518c2ef5b8cd1ULL, 0x7eb258665fc25d69ULL, 0x98bf2f79d5993802ULL, 0xef2f773ffbd97a61ULL,
+    0xbeeefb584aff8603ULL, 0xaafb550ffacfd8faULL, 0xeeaaba2e5dbf6784ULL, 0x95ba2a53f983cf38ULL,
+    0x952ab45cfa97a0b2ULL, 0xdd945a747bf26183ULL, 0xba756174393d88dfULL, 0x94f971119aeef9e4ULL,
+    0xe912b9d1478ceb17ULL, 0x7a37cd5601aab85dULL, 0x91abb422ccb812eeULL, 0xac62e055c10ab33aULL,
+    0xb616a12b7fe617aaULL, 0x577b986b314d6009ULL, 0xe39c49765fdf9d94ULL, 0xed5a7e85fda0b80bULL,
+    0x8e41ade9fbebc27dULL, 0x14588f13be847307ULL, 0xb1d219647ae6b31cULL, 0x596eb2d8ae258fc8ULL,
+    0xde469fbd99a05fe3ULL, 0x6fca5f8ed9aef3bbULL, 0x8aec23d680043beeULL, 0x25de7bb9480d5854ULL,
+    0xada72ccc20054ae9ULL, 0xaf561aa79a10ae6aULL, 0xd910f7ff28069da4ULL, 0x1b2ba1518094da04ULL,
+    0x87aa9aff79042286ULL, 0x90fb44d2f05d0842ULL, 0xa99541bf57452b28ULL, 0x353a1607ac744a53ULL,
+    0xd3fa922f2d1675f2ULL, 0x42889b8997915ce8ULL, 0x847c9b5d7c2e09b7ULL, 0x69956135febada11ULL,
+    0xa59bc234db398c25ULL, 0x43fab9837e699095ULL, 0xcf02b2c21207ef2eULL, 0x94f967e45e03f4bbULL,
+    0x8161afb94b44f57dULL, 0x1d1be0eebac278f5ULL, 0xa1ba1ba79e1632dcULL, 0x6462d92a69731732ULL,
+    0xca28a291859bbf93ULL, 0x7d7b8f7503cfdcfeULL, 0xfcb2cb35e702af78ULL, 0x5cda735244c3d43eULL,
+    0x9defbf01b061adabULL, 0x3a0888136afa64a7ULL, 0xc56baec21c7a1916ULL, 0x088aaa1845b8fdd0ULL,
+    0xf6c69a72a3989f5bULL, 0x8aad549e57273d45ULL, 0x9a3c2087a63f6399ULL, 0x36ac54e2f678864bULL,
+    0xc0cb28a98fcf3c7fULL, 0x84576a1bb416a7ddULL, 0xf0fdf2d3f3c30b9fULL, 0x656d44a2a11c51d5ULL,
+    0x969eb7c47859e743ULL, 0x9f644ae5a4b1b325ULL, 0xbc4665b596706114ULL, 0x873d5d9f0dde1feeULL,
+    0xeb57ff22fc0c7959ULL, 0xa90cb506d155a7eaULL, 0x9316ff75dd87cbd8ULL, 0x09a7f12442d588f2ULL,
+    0xb7dcbf5354e9beceULL, 0x0c11ed6d538aeb2fULL, 0xe5d3ef282a242e81ULL, 0x8f1668c8a86da5faULL,
+    0x8fa475791a569d10ULL, 0xf96e017d694487bcULL, 0xb38d92d760ec4455ULL, 0x37c981dcc395a9acULL,
+    0xe070f78d3927556aULL, 0x85bbe253f47b1417ULL, 0x8c469ab843b89562ULL, 0x93956d7478ccec8eULL,
+    0xaf58416654a6babbULL, 0x387ac8d1970027b2ULL, 0xdb2e51bfe9d0696aULL, 0x06997b05fcc0319eULL,
+    0x88fcf317f22241e2ULL, 0x441fece3bdf81f03ULL, 0xab3c2fddeeaad25aULL, 0xd527e81cad7626c3ULL,
+    0xd60b3bd56a5586f1ULL, 0x8a71e223d8d3b074ULL, 0x85c7056562757456ULL, 0xf6872d5667844e49ULL,
+    0xa738c6bebb12d16cULL, 0xb428f8ac016561dbULL, 0xd106f86e69d785c7ULL, 0xe13336d701beba52ULL,
+    0x82a45b450226b39cULL, 0xecc0024661173473ULL, 0xa34d721642b06084ULL, 0x27f002d7f95d0190ULL,
+    0xcc20ce9bd35c78a5ULL, 0x31ec038df7b441f4ULL, 0xff290242c83396ceULL, 0x7e67047175a15271ULL,
+    0x9f79a169bd203e41ULL, 0x0f0062c6e984d386ULL, 0xc75809c42c684dd1ULL, 0x52c07b78a3e60868ULL,
+    0xf92e0c3537826145ULL, 0xa7709a56ccdf8a82ULL, 0x9bbcc7a142b17ccbULL, 0x88a66076400bb691ULL,
+    0xc2abf989935ddbfeULL, 0x6acff893d00ea435ULL, 0xf356f7ebf83552feULL, 0x0583f6b8c4124d43ULL,
+    0x98165af37b2153deULL, 0xc3727a337a8b704aULL, 0xbe1bf1b059e9a8d6ULL, 0x744f18c0592e4c5cULL,
+    0xeda2ee1c7064130cULL, 0x1162def06f79df73ULL, 0x9485d4d1c63e8be7ULL, 0x8addcb5645ac2ba8ULL,
+    0xb9a74a0637ce2ee1ULL, 0x6d953e2bd7173692ULL, 0xe8111c87c5c1ba99ULL, 0xc8fa8db6ccdd0437ULL,
+    0x910ab1d4db9914a0ULL, 0x1d9c9892400a22a2ULL, 0xb54d5e4a127f59c8ULL, 0x2503beb6d00cab4bULL,
+    0xe2a0b5dc971f303aULL, 0x2e44ae64840fd61dULL, 0x8da471a9de737e24ULL, 0x5ceaecfed289e5d2ULL,
+    0xb10d8e1456105dadULL, 0x7425a83e872c5f47ULL, 0xdd50f1996b947518ULL, 0xd12f124e28f77719ULL,
+    0x8a5296ffe33cc92fULL, 0x82bd6b70d99aaa6fULL, 0xace73cbfdc0bfb7bULL, 0x636cc64d1001550bULL,
+    0xd8210befd30efa5aULL, 0x3c47f7e05401aa4eULL, 0x8714a775e3e95c78ULL, 0x65acfaec34810a71ULL,
+    0xa8d9d1535ce3b396ULL, 0x7f1839a741a14d0dULL, 0xd31045a8341ca07cULL, 0x1ede48111209a050ULL,
+    0x83ea2b892091e44dULL, 0x934aed0aab460432ULL, 0xa4e4b66b68b65d60ULL, 0xf81da84d5617853fULL,
+    0xce1de40642e3f4b9ULL, 0x36251260ab9d668eULL, 0x80d2ae83e9ce78f3ULL, 0xc1d72b7c6b426019ULL,
+    0xa1075a24e4421730ULL, 0xb24cf65b8612f81fULL, 0xc94930ae1d529cfcULL, 0xdee033f26797b627ULL,
+    0xfb9b7cd9a4a7443cULL, 0x169840ef017da3b1ULL, 0x9d412e0806e88aa5ULL, 0x8e1f289560ee864eULL,
+    0xc491798a08a2ad4eULL, 0xf1a6f2bab92a27e2ULL, 0xf5b5d7ec8acb58a2ULL, 0xae10af696774b1dbULL,
+    0x9991a6f3d6bf1765ULL, 0xacca6da1e0a8ef29ULL, 0xbff610b0cc6edd3fULL, 0x17fd090a58d32af3ULL,
+    0xeff394dcff8a948eULL, 0xddfc4b4cef07f5b0ULL, 0x95f83d0a1fb69cd9ULL, 0x4abdaf101564f98eULL,
+    0xbb764c4ca7a4440fULL, 0x9d6d1ad41abe37f1ULL, 0xea53df5fd18d5513ULL, 0x84c86189216dc5edULL,
+    0x92746b9be2f8552cULL, 0x32fd3cf5b4e49bb4ULL, 0xb7118682dbb66a77ULL, 0x3fbc8c33221dc2a1ULL,
+    0xe4d5e82392a40515ULL, 0x0fabaf3feaa5334aULL, 0x8f05b1163ba6832dULL, 0x29cb4d87f2a7400eULL,
+    0xb2c71d5bca9023f8ULL, 0x743e20e9ef511012ULL, 0xdf78e4b2bd342cf6ULL, 0x914da9246b255416ULL,
+    0x8bab8eefb6409c1aULL, 0x1ad089b6c2f7548eULL, 0xae9672aba3d0c320ULL, 0xa184ac2473b529b1ULL,
+    0xda3c0f568cc4f3e8ULL, 0xc9e5d72d90a2741eULL, 0x8865899617fb1871ULL, 0x7e2fa67c7a658892ULL,
+    0xaa7eebfb9df9de8dULL, 0xddbb901b98feeab7ULL, 0xd51ea6fa85785631ULL, 0x552a74227f3ea565ULL,
+    0x8533285c936b35deULL, 0xd53a88958f87275fULL, 0xa67ff273b8460356ULL, 0x8a892abaf368f137ULL,
+    0xd01fef10a657842cULL, 0x2d2b7569b0432d85ULL, 0x8213f56a67f6b29bULL, 0x9c3b29620e29fc73ULL,
+    0xa298f2c501f45f42ULL, 0x8349f3ba91b47b8fULL, 0xcb3f2f7642717713ULL, 0x241c70a936219a73ULL,
+    0xfe0efb53d30dd4d7ULL, 0xed238cd383aa0110ULL, 0x9ec95d1463e8a506ULL, 0xf4363804324a40aaULL,
+    0xc67bb4597ce2ce48ULL, 0xb143c6053edcd0d5ULL, 0xf81aa16fdc1b81daULL, 0xdd94b7868e94050aULL,
+    0x9b10a4e5e9913128ULL, 0xca7cf2b4191c8326ULL, 0xc1d4ce1f63f57d72ULL, 0xfd1c2f611f63a3f0ULL,
+    0xf24a01a73cf2dccfULL, 0xbc633b39673c8cecULL, 0x976e41088617ca01ULL, 0xd5be0503e085d813ULL,
+    0xbd49d14aa79dbc82ULL, 0x4b2d8644d8a74e18ULL, 0xec9c459d51852ba2ULL, 0xddf8e7d60ed1219eULL,
+    0x93e1ab8252f33b45ULL, 0xcabb90e5c942b503ULL, 0xb8da1662e7b00a17ULL, 0x3d6a751f3b936243ULL,
+    0xe7109bfba19c0c9dULL, 0x0cc512670a783ad4ULL, 0x906a617d450187e2ULL, 0x27fb2b80668b24c5ULL,
+    0xb484f9dc9641e9daULL, 0xb1f9f660802dedf6ULL, 0xe1a63853bbd26451ULL, 0x5e7873f8a0396973ULL,
+    0x8d07e33455637eb2ULL, 0xdb0b487b6423e1e8ULL, 0xb049dc016abc5e5fULL, 0x91ce1a9a3d2cda62ULL,
+    0xdc5c5301c56b75f7ULL, 0x7641a140cc7810fbULL, 0x89b9b3e11b6329baULL, 0xa9e904c87fcb0a9dULL,
+    0xac2820d9623bf429ULL, 0x546345fa9fbdcd44ULL, 0xd732290fbacaf133ULL, 0xa97c177947ad4095ULL,
+    0x867f59a9d4bed6c0ULL, 0x49ed8eabcccc485dULL, 0xa81f301449ee8c70ULL, 0x5c68f256bfff5a74ULL,
+    0xd226fc195c6a2f8cULL, 0x73832eec6fff3111ULL, 0x83585d8fd9c25db7ULL, 0xc831fd53c5ff7eabULL,
+    0xa42e74f3d032f525ULL, 0xba3e7ca8b77f5e55ULL, 0xcd3a1230c43fb26fULL, 0x28ce1bd2e55f35ebULL,
+    0x80444b5e7aa7cf85ULL, 0x7980d163cf5b81b3ULL, 0xa0555e361951c366ULL, 0xd7e105bcc332621fULL,
+    0xc86ab5c39fa63440ULL, 0x8dd9472bf3fefaa7ULL, 0xfa856334878fc150ULL, 0xb14f98f6f0feb951ULL,
+    0x9c935e00d4b9d8d2ULL, 0x6ed1bf9a569f33d3ULL, 0xc3b8358109e84f07ULL, 0x0a862f80ec4700c8ULL,
+    0xf4a642e14c6262c8ULL, 0xcd27bb612758c0faULL, 0x98e7e9cccfbd7dbdULL, 0x8038d51cb897789cULL,
+    0xbf21e44003acdd2cULL, 0xe0470a63e6bd56c3ULL, 0xeeea5d5004981478ULL, 0x1858ccfce06cac74ULL,
+    0x95527a5202df0ccbULL, 0x0f37801e0c43ebc8ULL, 0xbaa718e68396cffdULL, 0xd30560258f54e6baULL,
+    0xe950df20247c83fdULL, 0x47c6b82ef32a2069ULL, 0x91d28b7416cdd27eULL, 0x4cdc331d57fa5441ULL,
+    0xb6472e511c81471dULL, 0xe0133fe4adf8e952ULL, 0xe3d8f9e563a198e5ULL, 0x58180fddd97723a6ULL,
+    0x8e679c2f5e44ff8fULL, 0x570f09eaa7ea7648ULL
+};
+
+const double cju_pow10_exact[23] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+struct cju_u128 {
+    uint64_t low;
+    uint64_t high;
+};
+
+#if defined(__SIZEOF_INT128__)
+__extension__ typedef unsigned __int128 cju_uint128;
+#endif
+
+struct cju_u128 cju_mul_64(uint64_t a, uint64_t b) {
+    struct cju_u128 r;
+#if defined(__SIZEOF_INT128__)
+    cju_uint128 p = (cju_uint128)a * b;
+    r.low = (uint64_t)p;
+    r.high = (uint64_t)(p >> 64);
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32, b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+    uint64_t cross = (lo_lo >> 32) + (uint32_t)hi_lo + lo_hi;
+    r.low = (cross << 32) | (uint32_t)lo_lo;
+    r.high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+#endif
+    return r;
+}
+
+unsigned int cju_leading_zeros_64(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_clzll(x);
+#else
+    unsigned int n = 0;
+    while (!(x & (1ULL << 63))) {
+        x <<= 1;
+        n++;
     }
+    return n;
+#endif
+}
 
-    for (size_t i = 0; i < str_len; i++) {
-        if (str[i] == '\\') {
-            // check if access to next char is safe
-            if (str_len <= i + 1) {
-                return cj_error_unexpected_eof;
+double cju_double_from_bits(bool negative, uint64_t power2, uint64_t mantissa) {
+    uint64_t bits = mantissa | power2 << 52 | (uint64_t)negative << 63;
+    double d;
+    memcpy(&d, &bits, sizeof(d));
+    return d;
+}
+
+/**
+ * Convert w * 10^q to the nearest double, w must not be zero. Returns false if the rounding can not be decided.
+ */
+bool cju_eisel_lemire(uint64_t w, int64_t q, bool negative, double* value) {
+    if (q < CJU_POW5_MIN) {
+        *value = cju_double_from_bits(negative, 0, 0);
+        return true;
+    }
+    if (q > CJU_POW5_MAX) {
+        *value = cju_double_from_bits(negative, 0x7FF, 0);
+        return true;
+    }
+
+    unsigned int lz = cju_leading_zeros_64(w);
+    w <<= lz;
+
+    size_t index = 2 * (q - CJU_POW5_MIN);
+    struct cju_u128 product = cju_mul_64(w, cju_pow5_128[index]);
+    if ((product.high & 0x1FF) == 0x1FF) {
+        struct cju_u128 second = cju_mul_64(w, cju_pow5_128[index + 1]);
+        product.low += second.high;
+        if (second.high > product.low) {
+            product.high++;
+        }
+    }
+    if (product.low == UINT64_MAX && (q < -27 || q > 55)) {
+        return false;
+    }
+
+    unsigned int upper_bit = product.high >> 63;
+    unsigned int shift = upper_bit + 9;
+    uint64_t mantissa = product.high >> shift;
+    // 217706 / 2^16 approximates log2(10)
+    int64_t power2 = ((217706 * q) >> 16) + 63 + upper_bit - lz + 1023;
+
+    if (power2 <= 0) {
+        // subnormal
+        if (-power2 + 1 >= 64) {
+            *value = cju_double_from_bits(negative, 0, 0);
+            return true;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (1ULL << 52) ? 0 : 1;
+        *value = cju_double_from_bits(negative, power2, mantissa & ((1ULL << 52) - 1));
+        return true;
+    }
+
+    // exactly halfway between two doubles, round to even
+    if (product.low <= 1 && q >= -4 && q <= 23 && (mantissa & 3) == 1 && (mantissa << shift) == product.high) {
+        mantissa &= ~1ULL;
+    }
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (2ULL << 52)) {
+        mantissa = 1ULL << 52;
+        power2++;
+    }
+    if (power2 >= 0x7FF) {
+        *value = cju_double_from_bits(negative, 0x7FF, 0);
+        return true;
+    }
+    *value = cju_double_from_bits(negative, power2, mantissa & ((1ULL << 52) - 1));
+    return true;
+}
+
+/**
+ * An arbitrary precision decimal d[0..nd) * 10^(dp - nd) used when cju_eisel_lemire can not decide. 800 digits are
+ * enough to round every double correctly, truncated is set if non zero digits had to be dropped.
+ */
+#define CJU_DECIMAL_DIGITS 800
+#define CJU_DECIMAL_MAX_SHIFT 60
+
+struct cju_decimal {
+    size_t nd;
+    int64_t dp;
+    bool truncated;
+    unsigned char d[CJU_DECIMAL_DIGITS];
+};
+
+void cju_decimal_trim(struct cju_decimal* a) {
+    while (a->nd > 0 && a->d[a->nd - 1] == 0) {
+        a->nd--;
+    }
+    if (a->nd == 0) {
+        a->dp = 0;
+    }
+}
+
+void cju_decimal_right_shift(struct cju_decimal* a, unsigned int k) {
+    size_t r = 0;
+    size_t w = 0;
+    uint64_t n = 0;
+    for (; n >> k == 0; r++) {
+        if (r >= a->nd) {
+            if (n == 0) {
+                a->nd = 0;
+                return;
+            }
+            while (n >> k == 0) {
+                n *= 10;
+                r++;
+            }
+            break;
+        }
+        n = n * 10 + a->d[r];
+    }
+    a->dp -= (int64_t)r - 1;
+
+    uint64_t mask = (1ULL << k) - 1;
+    for (; r < a->nd; r++) {
+        uint64_t digit = n >> k;
+        n &= mask;
+        a->d[w++] = digit;
+        n = n * 10 + a->d[r];
+    }
+    while (n > 0) {
+        uint64_t digit = n >> k;
+        n &= mask;
+        if (w < CJU_DECIMAL_DIGITS) {
+            a->d[w++] = digit;
+        } else if (digit > 0) {
+            a->truncated = true;
+        }
+        n *= 10;
+    }
+    a->nd = w;
+    cju_decimal_trim(a);
+}
+
+void cju_decimal_left_shift(struct cju_decimal* a, unsigned int k) {
+    // a shift by up to 60 bits adds at most 19 digits, build the result backwards and move it to the front
+    unsigned char digits[CJU_DECIMAL_DIGITS + 20];
+    size_t w = sizeof(digits);
+    uint64_t n = 0;
+    for (size_t r = a->nd; r > 0; r--) {
+        n += (uint64_t)a->d[r - 1] << k;
+        digits[--w] = n % 10;
+        n /= 10;
+    }
+    while (n > 0) {
+        digits[--w] = n % 10;
+        n /= 10;
+    }
+
+    size_t nd = sizeof(digits) - w;
+    a->dp += nd - a->nd;
+    if (nd > CJU_DECIMAL_DIGITS) {
+        for (size_t i = CJU_DECIMAL_DIGITS; i < nd; i++) {
+            a->truncated |= digits[w + i] != 0;
+        }
+        nd = CJU_DECIMAL_DIGITS;
+    }
+    memcpy(a->d, &digits[w], nd);
+    a->nd = nd;
+    cju_decimal_trim(a);
+}
+
+void cju_decimal_shift(struct cju_decimal* a, int64_t k) {
+    if (a->nd == 0) {
+        return;
+    }
+    for (; k > CJU_DECIMAL_MAX_SHIFT; k -= CJU_DECIMAL_MAX_SHIFT) {
+        cju_decimal_left_shift(a, CJU_DECIMAL_MAX_SHIFT);
+    }
+    for (; k < -CJU_DECIMAL_MAX_SHIFT; k += CJU_DECIMAL_MAX_SHIFT) {
+        cju_decimal_right_shift(a, CJU_DECIMAL_MAX_SHIFT);
+    }
+    if (k > 0) {
+        cju_decimal_left_shift(a, k);
+    } else if (k < 0) {
+        cju_decimal_right_shift(a, -k);
+    }
+}
+
+/**
+ * The integer part of a rounded half to even.
+ */
+uint64_t cju_decimal_rounded_integer(struct cju_decimal* a) {
+    if (a->dp > 20) {
+        return UINT64_MAX;
+    }
+    uint64_t n = 0;
+    int64_t i = 0;
+    for (; i < a->dp && i < (int64_t)a->nd; i++) {
+        n = n * 10 + a->d[i];
+    }
+    for (; i < a->dp; i++) {
+        n *= 10;
+    }
+
+    if (a->dp >= 0 && a->dp < (int64_t)a->nd) {
+        unsigned char next = a->d[a->dp];
+        if (next == 5 && a->dp + 1 == (int64_t)a->nd) {
+            n += a->truncated || (a->dp > 0 && a->d[a->dp - 1] % 2 == 1);
+        } else {
+            n += next >= 5;
+        }
+    }
+    return n;
+}
+
+/**
+ * The number of bits to shift a cju_decimal by to move its decimal point by one to eight digits without overshooting.
+ */
+const unsigned char cju_decimal_powers[] = {1, 3, 6, 9, 13, 16, 19, 23, 26};
+
+/**
+ * Parse the digits of the already validated number between start and end and convert them exactly.
+ */
+double cju_decimal_to_double(char* start, char* end) {
+    struct cju_decimal a = {.nd = 0, .dp = 0, .truncated = false};
+    bool negative = false;
+    bool seen_dot = false;
+    char* p = start;
+
+    if (*p == '-') {
+        negative = true;
+        p++;
+    }
+    for (; p < end && (CJ_IS_DIGIT(*p) || *p == '.'); p++) {
+        if (*p == '.') {
+            seen_dot = true;
+            continue;
+        }
+        if (*p == '0' && a.nd == 0) {
+            // leading zeros only move the decimal point
+            a.dp -= seen_dot;
+            continue;
+        }
+        if (a.nd < CJU_DECIMAL_DIGITS) {
+            a.d[a.nd++] = *p - '0';
+        } else {
+            a.truncated |= *p != '0';
+        }
+        a.dp += !seen_dot;
+    }
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        p++;
+        bool negative_exponent = *p == '-';
+        if (*p == '-' || *p == '+') {
+            p++;
+        }
+        int64_t exponent = 0;
+        for (; p < end && CJ_IS_DIGIT(*p); p++) {
+            if (exponent < 100000) {
+                exponent = exponent * 10 + (*p - '0');
+            }
+        }
+        a.dp += negative_exponent ? -exponent : exponent;
+    }
+    cju_decimal_trim(&a);
+
+    if (a.nd == 0 || a.dp < -330) {
+        return cju_double_from_bits(negative, 0, 0);
+    }
+    if (a.dp > 310) {
+        return cju_double_from_bits(negative, 0x7FF, 0);
+    }
+
+    // scale by powers of two into [0.5, 1)
+    int64_t power2 = 0;
+    while (a.dp > 0) {
+        int64_t n = a.dp >= (int64_t)sizeof(cju_decimal_powers) ? 27 : cju_decimal_powers[a.dp];
+        cju_decimal_shift(&a, -n);
+        power2 += n;
+    }
+    while (a.dp < 0 || (a.dp == 0 && a.d[0] < 5)) {
+        int64_t n = -a.dp >= (int64_t)sizeof(cju_decimal_powers) ? 27 : cju_decimal_powers[-a.dp];
+        cju_decimal_shift(&a, n);
+        power2 -= n;
+    }
+
+    // doubles are in [1, 2)
+    power2--;
+    if (power2 < -1022) {
+        cju_decimal_shift(&a, power2 + 1022);
+        power2 = -1022;
+    }
+    if (power2 + 1023 >= 0x7FF) {
+        return cju_double_from_bits(negative, 0x7FF, 0);
+    }
+
+    cju_decimal_shift(&a, 53);
+    uint64_t mantissa = cju_decimal_rounded_integer(&a);
+    if (mantissa == (2ULL << 52)) {
+        mantissa >>= 1;
+        power2++;
+        if (power2 + 1023 >= 0x7FF) {
+            return cju_double_from_bits(negative, 0x7FF, 0);
+        }
+    }
+    if (!(mantissa & (1ULL << 52))) {
+        // subnormal
+        power2 = -1023;
+    }
+    return cju_double_from_bits(negative, power2 + 1023, mantissa & ((1ULL << 52) - 1));
+}
+
+enum cj_error_code cj_open_void(enum cj_container_type type, void* parent, unsigned int parent_tag, union cj_key* key,
+                                void** open, unsigned int* tag) {
+    (void)type;
+    (void)parent;
+    (void)parent_tag;
+    (void)key;
+    (void)open;
+    (void)tag;
+    return cj_error_none;
+}
+
+enum cj_error_code cj_push_void(void* this, unsigned int tag, size_t index, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    (void)index;
+    (void)value;
+    return cj_error_none;
+}
+
+enum cj_error_code cj_set_void(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    (void)id;
+    (void)value;
+    return cj_error_none;
+}
+
+enum cj_error_code cj_span_validate(struct cj_span* s) {
+    char* str = s->ptr + 1;
+    size_t str_len = s->length - 2;
+
+    if (s->info & cj_span_info_decoded) {
+        return cj_error_none;
+    }
+
+    if (s->length < 2 || s->ptr[0] != '"' || s->ptr[s->length - 1] != '"') {
+        return cj_error_span_not_enclosed_by_quotes;
+    }
+
+    for (size_t i = 0; i < str_len; i++) {
+        if (str[i] == '\\') {
+            // check if access to next char is safe
+            if (str_len <= i + 1) {
+                return cj_error_unexpected_eof;
             }
             switch (str[i + 1]) {
                 case '"':
@@ -704,8 +1946,14 @@ enum cj_error_code cj_span_validate(struct cj_span* s) {
                 case 'u':
                     size_t escaped_hex_bytes = 0;
                     unsigned int code_point = 0;
-                    if (!cju_parse_unicode(&str[i], &code_point, &escaped_hex_bytes)) {
-                        return cj_error_exp_hex;
+                    if (!cju_parse_unicode(&str[i], str_len - i, &code_point, &escaped_hex_bytes)) {
+                        // four hex digits which do not decode are a surrogate without its other half
+                        for (size_t h = 2; h < 6; h++) {
+                            if (i + h >= str_len || !(CJ_CC(str[i + h]) & CJ_CC_HEX)) {
+                                return cj_error_exp_hex;
+                            }
+                        }
+                        return cj_error_unpaired_surrogate;
                     }
                     i += escaped_hex_bytes - 1;  // "\u" + 4 * <hex> + ("\u" + <hex>)?
                     break;
@@ -721,6 +1969,10 @@ size_t cj_span_len(struct cj_span* s) {
     char* str = s->ptr + 1;
     size_t str_len = s->length - 2;
 
+    if (s->info & cj_span_info_scanned) {
+        return s->decoded_length;
+    }
+
     assert(s->length >= 2);
     assert(s->ptr[0] == '"');
     assert(s->ptr[s->length - 1] == '"');
@@ -728,9 +1980,8 @@ size_t cj_span_len(struct cj_span* s) {
     size_t len = 0;
 
     for (size_t i = 0; i < str_len; i++) {
-        if (str[i] == '\\') {
-            // check if access to next char is safe
-            assert(str_len > i + 1);
+        // a trailing '\\' is kept as it is like any other escape the parser rejects, see cju_unescape
+        if (str[i] == '\\' && i + 1 < str_len) {
             switch (str[i + 1]) {
                 case '"':
                 case '\\':
@@ -746,13 +1997,18 @@ size_t cj_span_len(struct cj_span* s) {
                 case 'u':
                     size_t escaped_hex_bytes = 0;
                     unsigned int code_point = 0;
-                    assert(cju_parse_unicode(&str[i], &code_point, &escaped_hex_bytes));
+                    if (!cju_parse_unicode(&str[i], str_len - i, &code_point, &escaped_hex_bytes)) {
+                        // kept as it is, see cju_unescape
+                        len++;
+                        break;
+                    }
                     size_t utf8_len = cju_code_point_utf8_length(code_point);
                     len += utf8_len;
                     i += escaped_hex_bytes - 1;  // "\u" + 4 * <hex> + ("\u" + <hex>)?
                     break;
                 default:
-                    assert("no other characters are allowed after \\" && false);
+                    len++;
+                    break;
             }
         } else {
             len++;
@@ -774,6 +2030,10 @@ bool cj_span_eq(struct cj_span* s, char* eq_str) {
     char* str = s->ptr + 1;
     size_t str_len = s->length - 2;
 
+    if (s->info & cj_span_info_decoded) {
+        return eq_str_len == s->length && memcmp(s->ptr, eq_str, eq_str_len) == 0;
+    }
+
     assert(s->length >= 2);
     assert(s->ptr[0] == '"');
     assert(s->ptr[s->length - 1] == '"');
@@ -781,12 +2041,19 @@ bool cj_span_eq(struct cj_span* s, char* eq_str) {
     if (eq_str_len > str_len) {
         return false;
     }
+    if (s->info & cj_span_info_scanned) {
+        if (eq_str_len != s->decoded_length) {
+            return false;
+        }
+        if (!(s->info & cj_span_info_escaped)) {
+            return memcmp(str, eq_str, str_len) == 0;
+        }
+    }
 
     size_t i = 0;
     size_t j = 0;
     for (; i < str_len && j < eq_str_len; i++, j++) {
-        if (str[i] == '\\') {
-            assert(str_len > i + 1);
+        if (str[i] == '\\' && i + 1 < str_len) {
             switch (str[i + 1]) {
                 CJ_STREQ_ESC_CASE('"', '"')
                 CJ_STREQ_ESC_CASE('\\', '\\')
@@ -800,7 +2067,13 @@ bool cj_span_eq(struct cj_span* s, char* eq_str) {
                     size_t escaped_hex_bytes = 0;
                     unsigned int code_point = 0;
 
-                    assert(cju_parse_unicode(&str[i], &code_point, &escaped_hex_bytes));
+                    if (!cju_parse_unicode(&str[i], str_len - i, &code_point, &escaped_hex_bytes)) {
+                        // kept as it is, see cju_unescape
+                        if (eq_str[j] != '\\') {
+                            return false;
+                        }
+                        break;
+                    }
                     char utf8[4] = {0};
                     size_t utf8_len = cju_code_point_utf8_length(code_point);
                     cju_code_point_to_utf8(code_point, utf8, utf8_len);
@@ -814,7 +2087,10 @@ bool cj_span_eq(struct cj_span* s, char* eq_str) {
                     j += utf8_len - 1;
                     break;
                 default:
-                    assert("no other characters are allowed after \\" && false);
+                    if (eq_str[j] != '\\') {
+                        return false;
+                    }
+                    break;
             }
         } else if (eq_str[j] != str[i]) {
             break;
@@ -840,18 +2116,28 @@ void cj_span_cpy(struct cj_span* span, char* buffer, size_t n) {
     char* str = span->ptr + 1;
     size_t str_len = span->length - 2;
 
+    if (span->info & cj_span_info_decoded) {
+        size_t length = span->length < n ? span->length : n - 1;
+        memcpy(buffer, span->ptr, length);
+        buffer[length] = '\0';
+        return;
+    }
+
     assert(span->length >= 2);
     assert(span->ptr[0] == '"');
     assert(span->ptr[span->length - 1] == '"');
 
+    if (n > str_len) {
+        cj_span_unescape(span, buffer);
+        return;
+    }
+
     size_t write_length = n - 1;
 
     size_t write_ptr = 0;
     bool for_loop = false;
     for (size_t i = 0; i < str_len && !for_loop; i++) {
-        if (str[i] == '\\') {
-            // check if access to next char is safe
-            assert(str_len > i + 1);
+        if (str[i] == '\\' && i + 1 < str_len) {
             switch (str[i + 1]) {
                 CJ_STRCPY_CASE('"', '"')
                 CJ_STRCPY_CASE('\\', '\\')
@@ -876,7 +2162,12 @@ void cj_span_cpy(struct cj_span* span, char* buffer, size_t n) {
                     unsigned int code_point = 0;
                     char utf8_bytes[4] = {0};
 
-                    assert(cju_parse_unicode(&str[i], &code_point, &escaped_hex_bytes));
+                    if (!cju_parse_unicode(&str[i], str_len - i, &code_point, &escaped_hex_bytes)) {
+                        // kept as it is, see cju_unescape
+                        CJ_BREAK_LOOP(write_ptr >= write_length, for_loop);
+                        buffer[write_ptr++] = '\\';
+                        break;
+                    }
                     size_t utf8_len = cju_code_point_utf8_length(code_point);
                     cju_code_point_to_utf8(code_point, utf8_bytes, utf8_len);
 
@@ -888,7 +2179,9 @@ void cj_span_cpy(struct cj_span* span, char* buffer, size_t n) {
                     i += escaped_hex_bytes - 1;
                     break;
                 default:
-                    assert("no other characters are allowed after \\" && false);
+                    CJ_BREAK_LOOP(write_ptr >= write_length, for_loop);
+                    buffer[write_ptr++] = '\\';
+                    break;
             }
         } else {
             CJ_BREAK_LOOP(write_ptr >= write_length, for_loop);
@@ -898,391 +2191,2197 @@ void cj_span_cpy(struct cj_span* span, char* buffer, size_t n) {
     buffer[write_ptr] = '\0';
 }
 
-char* cj_span_dup(struct cj_span* span) {
-    size_t len = cj_span_len(span);
-    char* buffer = malloc(sizeof(char) * (len + 1));
-    memset(buffer, 0, (len + 1));
-    cj_span_cpy(span, buffer, len + 1);
-    return buffer;
-}
+/**
+ * Decode the escaped string [str, end) to out and terminate it with '\0', returns the decoded length. out may point to
+ * str for in place decoding, it never overtakes str.
+ */
+size_t cju_unescape(char* str, char* end, char* out) {
+    char* start = out;
+    while (str < end) {
+        // copy everything up to the next escape in one go
+        char* escape = memchr(str, '\\', end - str);
+        size_t run = (escape == NULL ? end : escape) - str;
+        if (out != str) {
+            memmove(out, str, run);
+        }
+        out += run;
+        if (escape == NULL) {
+            break;
+        }
 
-void cj_parse_consume_opt_ws(char** b) {
-    while (**b == '\n' || **b == ' ' || **b == '\r' || **b == '\t') {
-        *b = *b + 1;
+        // escapes the parser rejects are kept as they are, the output never gets longer than the input
+        if (end - escape < 2) {
+            *out++ = '\\';
+            break;
+        }
+        str = escape + 2;
+        switch (escape[1]) {
+            case '"':
+            case '\\':
+            case '/':
+                *out++ = escape[1];
+                break;
+            case 'b':
+                *out++ = '\b';
+                break;
+            case 'f':
+                *out++ = '\f';
+                break;
+            case 'n':
+                *out++ = '\n';
+                break;
+            case 'r':
+                *out++ = '\r';
+                break;
+            case 't':
+                *out++ = '\t';
+                break;
+            case 'u': {
+                size_t escaped_hex_bytes = 0;
+                unsigned int code_point = 0;
+                if (!cju_parse_unicode(escape, end - escape, &code_point, &escaped_hex_bytes)) {
+                    // the "\\" is kept and "u..." goes on as text
+                    *out++ = '\\';
+                    str = escape + 1;
+                    break;
+                }
+                size_t utf8_len = cju_code_point_utf8_length(code_point);
+                cju_code_point_to_utf8(code_point, out, utf8_len);
+                out += utf8_len;
+                str = escape + escaped_hex_bytes;
+                break;
+            }
+            default:
+                *out++ = '\\';
+                str = escape + 1;
+                break;
+        }
     }
+    *out = '\0';
+    return out - start;
 }
 
-enum cj_error_code cj_consume_comma(char** b) {
-    if (**b != ',') {
-        return cj_error_exp_comma;
+size_t cj_span_unescape(struct cj_span* span, char* buffer) {
+    char* str = span->ptr + 1;
+    char* end = span->ptr + span->length - 1;
+
+    if (span->info & cj_span_info_decoded) {
+        memcpy(buffer, span->ptr, span->length + 1);
+        return span->length;
     }
-    *b = *b + 1;
-    return cj_error_none;
-}
 
-enum cj_error_code cj_consume_colon(char** b) {
-    if (**b != ':') {
-        return cj_error_exp_colon;
+    assert(span->length >= 2);
+    assert(span->ptr[0] == '"');
+    assert(span->ptr[span->length - 1] == '"');
+
+    if ((span->info & (cj_span_info_scanned | cj_span_info_escaped)) == cj_span_info_scanned) {
+        memcpy(buffer, str, end - str);
+        buffer[end - str] = '\0';
+        return end - str;
     }
-    *b = *b + 1;
-    return cj_error_none;
+
+    return cju_unescape(str, end, buffer);
 }
 
-enum cj_error_code cj_peek_type(char** b, enum cj_type* next) {
-    switch (**b) {
-        case '{':
-            *next = cj_type_object;
-            return 0;
-        case '[':
-            *next = cj_type_array;
-            return 0;
-        case '"':
-            *next = cj_type_string;
-            return 0;
-        case 'f':
-        case 't':
-            *next = cj_type_bool;
-            return 0;
-        case 'n':
-            *next = cj_type_null;
-            return 0;
-        case '-':
-        case '0':
-        case '1':
-        case '2':
-        case '3':
-        case '4':
-        case '5':
-        case '6':
-        case '7':
-        case '8':
-        case '9':
-            *next = cj_type_number;
-            return 0;
-        default:
-            return cj_error_exp_value;
+char* cj_span_dup(struct cj_span* span) {
+    assert(span->length >= 2 || (span->info & cj_span_info_decoded));
+    size_t size = span->info & cj_span_info_scanned ? span->decoded_length + 1 : span->length - 1;
+    char* buffer = malloc(sizeof(char) * size);
+    if (buffer != NULL) {
+        cj_span_unescape(span, buffer);
     }
+    return buffer;
 }
 
-enum cj_error_code cj_parse_primitive(char** b, struct cj_value* value) {
-    enum cj_type peek_type;
-
-    CJ_ERROR_BUBBLE(cj_peek_type(b, &peek_type));
-
-    switch (peek_type) {
-        case cj_type_string:
-            return cj_parse_string(b, value);
-        case cj_type_number:
-            return cj_parse_number(b, value);
-        case cj_type_bool:
-            return cj_parse_bool(b, value);
-        case cj_type_null:
-            return cj_parse_null(b, value);
-        default:
-            return cj_error_exp_primitive_value;
+void cj_span_unescape_insitu(struct cj_span* span) {
+    if (span->info & cj_span_info_decoded) {
+        return;
+    }
+    assert(span->length >= 2);
+    char* str = span->ptr + 1;
+    char* end = span->ptr + span->length - 1;
+    size_t length;
+    if ((span->info & (cj_span_info_scanned | cj_span_info_escaped)) == cj_span_info_scanned) {
+        // nothing to decode, the closing quote becomes the terminator
+        *end = '\0';
+        length = end - str;
+    } else {
+        length = cju_unescape(str, end, str);
     }
+    *span = (struct cj_span){
+        .ptr = str, .length = length, .decoded_length = length, .info = cj_span_info_scanned | cj_span_info_decoded};
 }
 
-enum cj_error_code cj_parse_id(char** b, struct cj_span* id) {
-    struct cj_value value;
-    enum cj_error_code err = cj_parse_string(b, &value);
-    id->ptr = value.string.ptr;
-    id->length = value.string.length;
-    return err;
+/**
+ * Hashes eight bytes at a time, short keys take one or two rounds.
+ */
+uint32_t cj_hash(const char* str, size_t length) {
+    uint64_t h = 0x9E3779B97F4A7C15ULL ^ length;
+    uint64_t w;
+    while (length >= 8) {
+        memcpy(&w, str, 8);
+        h = (h ^ w) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 29;
+        str += 8;
+        length -= 8;
+    }
+    if (length > 0) {
+        w = 0;
+        memcpy(&w, str, length);
+        h = (h ^ w) * 0xBF58476D1CE4E5B9ULL;
+        h ^= h >> 29;
+    }
+    h *= 0x94D049BB133111EBULL;
+    return (uint32_t)(h >> 32);
 }
 
-enum cj_error_code cj_parse_string(char** b, struct cj_value* value) {
-    value->type = cj_type_string;
-
-    if (**b != '"') {
-        return cj_error_exp_quote;
-    }
+#define CJ_KEY_MATCHER_MUL 0x9E3779B1u
+#define CJ_KEY_MATCHER_MAX_DISPLACE 4096
 
-    value->string.ptr = *b;
-    *b = *b + 1;
+/**
+ * Slot of a key with hash in a perfect table, displace is the value of the bucket of the key.
+ */
+size_t cj_key_matcher_slot(uint32_t hash, uint32_t displace, unsigned int shift) {
+    return (uint32_t)((hash ^ displace) * CJ_KEY_MATCHER_MUL) >> shift;
+}
 
-    while (**b != '"') {
-        CJ_ERROR_BUBBLE(cj_bytes_available(b, 1));
-        if (**b == '\\') {
-            *b = *b + 1;
-            CJ_ERROR_BUBBLE(cj_bytes_available(b, 1));
-            switch (**b) {
-                case '\"':
-                case '\\':
-                case '/':
-                case 'b':
-                case 'f':
-                case 'n':
-                case 'r':
-                case 't':
-                    break;
-                case 'u':
-                    *b = *b + 1;
-                    CJ_ERROR_BUBBLE(cj_bytes_available(b, 4));
-                    for (size_t i = 0; i < 4; i++, *b += 1) {
-                        if ((**b < '0' || **b > '9') && (**b < 'a' || **b > 'f') && (**b < 'A' || **b > 'F')) {
-                            return cj_error_exp_hex;
-                        }
-                    }
-                    break;
-                default:
-                    return cj_error_exp_escaped_character;
+/**
+ * Look up the decoded key [str, str + length) with its cj_hash, returns the key index or -1.
+ */
+int cj_key_matcher_lookup(const struct cj_key_matcher* m, const char* str, size_t length, uint32_t hash) {
+    if (m->displace != NULL) {
+        const struct cj_key_matcher_slot* slot =
+            &m->slots[cj_key_matcher_slot(hash, m->displace[hash >> m->bucket_shift], m->shift)];
+        size_t index = slot->index - 1;
+        if (slot->index != 0 && slot->hash == hash && m->lengths[index] == length &&
+            memcmp(m->keys[index], str, length) == 0) {
+            return index;
+        }
+        return -1;
+    }
+    for (size_t i = hash & m->mask; m->slots[i].index != 0; i = (i + 1) & m->mask) {
+        struct cj_key_matcher_slot* slot = &m->slots[i];
+        size_t index = slot->index - 1;
+        if (slot->hash == hash && m->lengths[index] == length && memcmp(m->keys[index], str, length) == 0) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Place the n keys in entries (all of one bucket) in free slots of a perfect table with capacity 1 << (32 - shift).
+ * Displacements are tried in order, the first that moves every key to a free slot is stored in *displace.
+ */
+bool cj_key_matcher_place(struct cj_key_matcher_slot* slots, unsigned int shift,
+                          const struct cj_key_matcher_slot* entries, size_t n, uint32_t* displace) {
+    for (uint32_t d = 0; d < CJ_KEY_MATCHER_MAX_DISPLACE; d++) {
+        // spread small displacements over all bits
+        uint32_t value = d * 0x85EBCA6Bu;
+        size_t placed = 0;
+        while (placed < n) {
+            size_t slot = cj_key_matcher_slot(entries[placed].hash, value, shift);
+            if (slots[slot].index != 0) {
+                break;
+            }
+            slots[slot] = entries[placed];
+            placed++;
+        }
+        if (placed == n) {
+            *displace = value;
+            return true;
+        }
+        while (placed > 0) {
+            placed--;
+            slots[cj_key_matcher_slot(entries[placed].hash, value, shift)].index = 0;
+        }
+    }
+    return false;
+}
+
+/**
+ * Replace the linear probing table of m with a perfect table (hash and displace): the keys are grouped into buckets by
+ * the high bits of their hash and the buckets are placed from the largest to the smallest, each with its own
+ * displacement. Larger tables are tried if a bucket can not be placed. Returns false and keeps the probing table if no
+ * perfect table was found, e.g. if two keys have the same hash.
+ */
+bool cj_key_matcher_make_perfect(struct cj_key_matcher* m) {
+    size_t probe_capacity = m->mask + 1;
+    size_t unique = 0;
+    for (size_t i = 0; i < probe_capacity; i++) {
+        unique += m->slots[i].index != 0;
+    }
+    if (unique == 0) {
+        return false;
+    }
+
+    // about two keys per bucket
+    unsigned int bucket_bits = 1;
+    while (((size_t)1 << bucket_bits) * 2 < unique) {
+        bucket_bits++;
+    }
+    size_t buckets = (size_t)1 << bucket_bits;
+    unsigned int bucket_shift = 32 - bucket_bits;
+
+    size_t* start = calloc(buckets + 1, sizeof(size_t));
+    size_t* fill = calloc(buckets, sizeof(size_t));
+    struct cj_key_matcher_slot* entries = malloc(unique * sizeof(struct cj_key_matcher_slot));
+    uint32_t* displace = calloc(buckets, sizeof(uint32_t));
+    struct cj_key_matcher_slot* slots = NULL;
+    bool found = false;
+    if (start == NULL || fill == NULL || entries == NULL || displace == NULL) {
+        goto done;
+    }
+
+    // sort the keys by bucket, bucket b holds entries[start[b]] up to entries[start[b + 1] - 1]
+    size_t max_size = 0;
+    for (size_t i = 0; i < probe_capacity; i++) {
+        if (m->slots[i].index != 0) {
+            start[(m->slots[i].hash >> bucket_shift) + 1]++;
+        }
+    }
+    for (size_t b = 0; b < buckets; b++) {
+        max_size = start[b + 1] > max_size ? start[b + 1] : max_size;
+        start[b + 1] += start[b];
+    }
+    for (size_t i = 0; i < probe_capacity; i++) {
+        if (m->slots[i].index != 0) {
+            size_t b = m->slots[i].hash >> bucket_shift;
+            entries[start[b] + fill[b]++] = m->slots[i];
+        }
+    }
+
+    for (size_t capacity = probe_capacity; capacity <= probe_capacity * 8 && !found; capacity *= 2) {
+        unsigned int bits = 0;
+        while (((size_t)1 << bits) < capacity) {
+            bits++;
+        }
+        unsigned int shift = 32 - bits;
+        free(slots);
+        slots = calloc(capacity, sizeof(struct cj_key_matcher_slot));
+        if (slots == NULL) {
+            goto done;
+        }
+        found = true;
+        // large buckets are the hardest to place, they go first
+        for (size_t size = max_size; size > 0 && found; size--) {
+            for (size_t b = 0; b < buckets && found; b++) {
+                size_t n = start[b + 1] - start[b];
+                if (n == size) {
+                    found = cj_key_matcher_place(slots, shift, entries + start[b], n, &displace[b]);
+                }
+            }
+        }
+        if (found) {
+            free(m->slots);
+            m->slots = slots;
+            m->displace = displace;
+            m->mask = capacity - 1;
+            m->shift = shift;
+            m->bucket_shift = bucket_shift;
+            slots = NULL;
+            displace = NULL;
+        }
+    }
+
+done:
+    free(start);
+    free(fill);
+    free(entries);
+    free(displace);
+    free(slots);
+    return found;
+}
+
+enum cj_error_code cj_key_matcher_init(struct cj_key_matcher* m, const char* const* keys, size_t count) {
+    assert(count < INT_MAX);
+    // at most half of the slots are used, which keeps probe sequences short
+    size_t capacity = 2;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+    *m = (struct cj_key_matcher){.keys = keys, .mask = capacity - 1, .count = count};
+    m->slots = calloc(capacity, sizeof(struct cj_key_matcher_slot));
+    m->lengths = malloc((count > 0 ? count : 1) * sizeof(size_t));
+    if (m->slots == NULL || m->lengths == NULL) {
+        cj_key_matcher_free(m);
+        return cj_error_out_of_memory;
+    }
+
+    for (size_t k = 0; k < count; k++) {
+        size_t length = strlen(keys[k]);
+        uint32_t hash = cj_hash(keys[k], length);
+        m->lengths[k] = length;
+        m->max_length = length > m->max_length ? length : m->max_length;
+        if (cj_key_matcher_lookup(m, keys[k], length, hash) != -1) {
+            continue;  // duplicate, the first index wins
+        }
+        size_t i = hash & m->mask;
+        while (m->slots[i].index != 0) {
+            i = (i + 1) & m->mask;
+        }
+        m->slots[i] = (struct cj_key_matcher_slot){.hash = hash, .index = k + 1};
+    }
+    // the probing table stays in use if no perfect table is found
+    cj_key_matcher_make_perfect(m);
+    return cj_error_none;
+}
+
+int cj_key_matcher_find(const struct cj_key_matcher* m, struct cj_span* id) {
+    const char* str;
+    size_t length;
+    if (id->info & cj_span_info_decoded) {
+        str = id->ptr;
+        length = id->length;
+    } else if ((id->info & (cj_span_info_scanned | cj_span_info_escaped)) == cj_span_info_scanned) {
+        str = id->ptr + 1;
+        length = id->length - 2;
+    } else {
+        // keys with escapes are rare, compare them one by one instead of decoding them first
+        for (size_t k = 0; k < m->count; k++) {
+            if (cj_span_eq(id, (char*)m->keys[k])) {
+                return k;
             }
         }
+        return -1;
+    }
+    if (length > m->max_length) {
+        return -1;
+    }
+    uint32_t hash = id->info & cj_span_info_hashed ? id->hash : cj_hash(str, length);
+    return cj_key_matcher_lookup(m, str, length, hash);
+}
+
+void cj_key_matcher_free(struct cj_key_matcher* m) {
+    free(m->slots);
+    free(m->lengths);
+    free(m->displace);
+    m->slots = NULL;
+    m->lengths = NULL;
+    m->displace = NULL;
+}
+
+#if defined(CJ_SIMD_SSE2) || defined(CJ_SIMD_AVX2)
+/**
+ * Skip white space in blocks of 32 (AVX2) or 16 (SSE2) bytes. Stops at the first non white space byte or if less than
+ * a block is left before end, the caller finishes with the scalar loop.
+ */
+char* cj_simd_skip_ws(char* p, char* end) {
+#if defined(CJ_SIMD_AVX2)
+    const __m256i sp32 = _mm256_set1_epi8(' ');
+    const __m256i nl32 = _mm256_set1_epi8('\n');
+    const __m256i cr32 = _mm256_set1_epi8('\r');
+    const __m256i ht32 = _mm256_set1_epi8('\t');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i ws = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, sp32), _mm256_cmpeq_epi8(v, nl32)),
+                                     _mm256_or_si256(_mm256_cmpeq_epi8(v, cr32), _mm256_cmpeq_epi8(v, ht32)));
+        uint32_t non_ws = ~(uint32_t)_mm256_movemask_epi8(ws);
+        if (non_ws != 0) {
+            return p + __builtin_ctz(non_ws);
+        }
+        p += 32;
+    }
+#endif
+    const __m128i sp = _mm_set1_epi8(' ');
+    const __m128i nl = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+    const __m128i ht = _mm_set1_epi8('\t');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(v, nl)),
+                                  _mm_or_si128(_mm_cmpeq_epi8(v, cr), _mm_cmpeq_epi8(v, ht)));
+        uint32_t non_ws = ~(uint32_t)_mm_movemask_epi8(ws) & 0xFFFF;
+        if (non_ws != 0) {
+            return p + __builtin_ctz(non_ws);
+        }
+        p += 16;
+    }
+    return p;
+}
+#endif
+
+void cj_parse_consume_opt_ws(char** b, char* end) {
+    // most separators are followed by no or a single white space, only go wide for longer runs (indentation)
+    if (!CJ_IS_WS(CJ_PEEK(b, end))) {
+        return;
+    }
+    *b = *b + 1;
+#if defined(CJ_SIMD_SSE2) || defined(CJ_SIMD_AVX2)
+    if (CJ_IS_WS(CJ_PEEK(b, end))) {
+        *b = cj_simd_skip_ws(*b, end);
+    }
+#endif
+    while (CJ_IS_WS(CJ_PEEK(b, end))) {
         *b = *b + 1;
     }
+}
+
+enum cj_error_code cj_consume_comma(char** b, char* end) {
+    if (CJ_PEEK(b, end) != ',') {
+        return cj_error_exp_comma;
+    }
+    *b = *b + 1;
+    return cj_error_none;
+}
+
+enum cj_error_code cj_consume_colon(char** b, char* end) {
+    if (CJ_PEEK(b, end) != ':') {
+        return cj_error_exp_colon;
+    }
+    *b = *b + 1;
+    return cj_error_none;
+}
+
+enum cj_error_code cj_peek_type(char** b, char* end, enum cj_type* next) {
+    unsigned int type = CJ_CC(CJ_PEEK(b, end)) >> CJ_CC_TYPE_SHIFT;
+    if (type == 0) {
+        return cj_error_exp_value;
+    }
+    *next = (enum cj_type)(type - 1);
+    return 0;
+}
+
+enum cj_error_code cj_parse_primitive(char** b, char* end, unsigned int flags, struct cj_value* value) {
+    enum cj_type peek_type;
+
+    CJ_ERROR_BUBBLE(cj_peek_type(b, end, &peek_type));
+
+    switch (peek_type) {
+        case cj_type_string:
+            CJ_ERROR_BUBBLE(cj_parse_string(b, end, value));
+            if (flags & cj_parse_insitu) {
+                cj_span_unescape_insitu(&value->string);
+            }
+            return cj_error_none;
+        case cj_type_number:
+            if (flags & cj_parse_lazy_numbers) {
+                return cj_parse_number_span(b, end, value);
+            }
+            return cj_parse_number(b, end, value);
+        case cj_type_bool:
+            return cj_parse_bool(b, end, value);
+        case cj_type_null:
+            return cj_parse_null(b, end, value);
+        default:
+            return cj_error_exp_primitive_value;
+    }
+}
+
+enum cj_error_code cj_parse_id(char** b, char* end, unsigned int flags, struct cj_span* id) {
+    struct cj_value value = {0};
+    CJ_ERROR_BUBBLE(cj_parse_string(b, end, &value));
+    if (flags & cj_parse_insitu) {
+        cj_span_unescape_insitu(&value.string);
+        value.string.hash = cj_hash(value.string.ptr, value.string.length);
+        value.string.info |= cj_span_info_hashed;
+    } else if (!(value.string.info & cj_span_info_escaped)) {
+        // the key was just scanned and is still in the cache
+        value.string.hash = cj_hash(value.string.ptr + 1, value.string.length - 2);
+        value.string.info |= cj_span_info_hashed;
+    }
+    *id = value.string;
+    return cj_error_none;
+}
+
+/**
+ * Return a pointer to the next '"', '\\' or control character (below 0x20) starting at p or end if there is none. Plain
+ * text is skipped in blocks of 32 (AVX2) or 16 (SSE2) bytes, the remaining bytes are checked one at a time.
+ */
+char* cj_scan_string(char* p, char* end) {
+#if defined(CJ_SIMD_AVX2)
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i backslash32 = _mm256_set1_epi8('\\');
+    const __m256i control32 = _mm256_set1_epi8(0x1F);
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        // unsigned v <= 0x1F
+        __m256i control = _mm256_cmpeq_epi8(_mm256_min_epu8(v, control32), v);
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, quote32), _mm256_cmpeq_epi8(v, backslash32)),
+                                      control);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+#endif
+#if defined(CJ_SIMD_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                   _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p != '"' && *p != '\\' && (unsigned char)*p >= 0x20) {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * Return a pointer to the next '"', '{', '}', '[' or ']' starting at p or end if there is none.
+ */
+char* cj_scan_skip(char* p, char* end) {
+#if defined(CJ_SIMD_AVX2)
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i lower32 = _mm256_set1_epi8(0x20);  // '[' | 0x20 == '{' and ']' | 0x20 == '}'
+    const __m256i ocb32 = _mm256_set1_epi8('{');
+    const __m256i ccb32 = _mm256_set1_epi8('}');
+    while (end - p >= 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)p);
+        __m256i vl = _mm256_or_si256(v, lower32);
+        __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote32),
+                                      _mm256_or_si256(_mm256_cmpeq_epi8(vl, ocb32), _mm256_cmpeq_epi8(vl, ccb32)));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 32;
+    }
+#endif
+#if defined(CJ_SIMD_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i lower = _mm_set1_epi8(0x20);
+    const __m128i ocb = _mm_set1_epi8('{');
+    const __m128i ccb = _mm_set1_epi8('}');
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)p);
+        __m128i vl = _mm_or_si128(v, lower);
+        __m128i hit =
+            _mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_or_si128(_mm_cmpeq_epi8(vl, ocb), _mm_cmpeq_epi8(vl, ccb)));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(hit);
+        if (mask != 0) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p != '"' && (*p | 0x20) != '{' && (*p | 0x20) != '}') {
+        p++;
+    }
+    return p;
+}
+
+/**
+ * Move *b from the opening bracket of a container past its matching closing bracket. Only brackets and strings are
+ * looked at, the content of the container is not validated. The kind of every open bracket is kept in a bit set so
+ * mismatched brackets fail like in the parser, nesting deeper than CJ_MAX_DEPTH fails with cj_error_max_depth.
+ */
+enum cj_error_code cj_skip_container(char** b, char* end) {
+    uint64_t objects[CJ_MAX_DEPTH / 64 + 1];
+    char* p = *b;
+    size_t depth = 0;
+    while (true) {
+        p = cj_scan_skip(p, end);
+        if (p == end) {
+            *b = end;
+            return cj_error_unexpected_eof;
+        }
+        if (*p == '"') {
+            p = cj_scan_string(p + 1, end);
+            // escapes and control characters are not checked, only the closing quote matters
+            while (p < end && *p != '"') {
+                if (*p == '\\' && end - p < 2) {
+                    p = end;
+                    break;
+                }
+                p = cj_scan_string(p + (*p == '\\' ? 2 : 1), end);
+            }
+            if (p == end) {
+                *b = end;
+                return cj_error_unexpected_eof;
+            }
+        } else if (*p == '{' || *p == '[') {
+            if (depth == CJ_MAX_DEPTH) {
+                *b = p;
+                return cj_error_max_depth;
+            }
+            if (*p == '{') {
+                objects[depth / 64] |= 1ULL << (depth % 64);
+            } else {
+                objects[depth / 64] &= ~(1ULL << (depth % 64));
+            }
+            depth++;
+        } else {
+            depth--;
+            bool object = (objects[depth / 64] >> (depth % 64)) & 1;
+            if (*p != (object ? '}' : ']')) {
+                *b = p;
+                return object ? cj_error_exp_close_curly_bracket : cj_error_exp_close_square_bracket;
+            }
+            if (depth == 0) {
+                *b = p + 1;
+                return cj_error_none;
+            }
+        }
+        p++;
+    }
+}
+
+// UTF-8 validation
+//
+// The AVX2 kernel implements the lookup algorithm from "Validating UTF-8 In Less Than One Instruction Per Byte" (Keiser,
+// Lemire 2021): three 16 entry tables indexed by nibbles of the current and previous byte flag every invalid two byte
+// combination, longer sequences are checked by comparing the bytes two and three positions back. Pure ASCII blocks only
+// cost a movemask. The scalar validator finds the exact position of an error.
+
+/**
+ * Return a pointer to the first byte of the first invalid UTF-8 sequence in [p, end) or NULL if all of it is valid.
+ */
+char* cj_utf8_find_invalid(char* p, char* end) {
+    while (p < end) {
+        unsigned char c = (unsigned char)*p;
+        if (c < 0x80) {
+            // skip ASCII runs 8 bytes at a time
+            uint64_t block;
+            while (end - p >= 8 && (memcpy(&block, p, 8), (block & 0x8080808080808080ULL) == 0)) {
+                p += 8;
+            }
+            if (p < end && (unsigned char)*p < 0x80) {
+                p++;
+            }
+            continue;
+        }
+
+        size_t n;
+        unsigned char min = 0x80, max = 0xBF;  // range of the second byte
+        if (c >= 0xC2 && c <= 0xDF) {
+            n = 2;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            n = 3;
+            min = c == 0xE0 ? 0xA0 : 0x80;  // overlong
+            max = c == 0xED ? 0x9F : 0xBF;  // surrogates
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            n = 4;
+            min = c == 0xF0 ? 0x90 : 0x80;  // overlong
+            max = c == 0xF4 ? 0x8F : 0xBF;  // above U+10FFFF
+        } else {
+            return p;
+        }
+        if ((size_t)(end - p) < n) {
+            return p;
+        }
+        if ((unsigned char)p[1] < min || (unsigned char)p[1] > max) {
+            return p;
+        }
+        for (size_t i = 2; i < n; i++) {
+            if (((unsigned char)p[i] & 0xC0) != 0x80) {
+                return p;
+            }
+        }
+        p += n;
+    }
+    return NULL;
+}
+
+#if defined(CJ_SIMD_AVX2)
+#define CJ_UTF8_TOO_SHORT (1 << 0)
+#define CJ_UTF8_TOO_LONG (1 << 1)
+#define CJ_UTF8_OVERLONG_3 (1 << 2)
+#define CJ_UTF8_TOO_LARGE (1 << 3)
+#define CJ_UTF8_SURROGATE (1 << 4)
+#define CJ_UTF8_OVERLONG_2 (1 << 5)
+#define CJ_UTF8_TOO_LARGE_1000 (1 << 6)
+#define CJ_UTF8_OVERLONG_4 (1 << 6)
+#define CJ_UTF8_TWO_CONTS (1 << 7)
+#define CJ_UTF8_CARRY (CJ_UTF8_TOO_SHORT | CJ_UTF8_TOO_LONG | CJ_UTF8_TWO_CONTS)
+
+// error flags for a byte depending on the high nibble of the previous byte
+const uint8_t cj_utf8_byte_1_high[16] = {
+    CJ_UTF8_TOO_LONG,
+    CJ_UTF8_TOO_LONG,
+    CJ_UTF8_TOO_LONG,
+    CJ_UTF8_TOO_LONG,
+    CJ_UTF8_TOO_LONG,
+    CJ_UTF8_TOO_LONG,
+    CJ_UTF8_TOO_LONG,
+    CJ_UTF8_TOO_LONG,
+    CJ_UTF8_TWO_CONTS,
+    CJ_UTF8_TWO_CONTS,
+    CJ_UTF8_TWO_CONTS,
+    CJ_UTF8_TWO_CONTS,
+    CJ_UTF8_TOO_SHORT | CJ_UTF8_OVERLONG_2,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT | CJ_UTF8_OVERLONG_3 | CJ_UTF8_SURROGATE,
+    CJ_UTF8_TOO_SHORT | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000 | CJ_UTF8_OVERLONG_4,
+};
+
+// error flags for a byte depending on the low nibble of the previous byte
+const uint8_t cj_utf8_byte_1_low[16] = {
+    CJ_UTF8_CARRY | CJ_UTF8_OVERLONG_3 | CJ_UTF8_OVERLONG_2 | CJ_UTF8_OVERLONG_4,
+    CJ_UTF8_CARRY | CJ_UTF8_OVERLONG_2,
+    CJ_UTF8_CARRY,
+    CJ_UTF8_CARRY,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000 | CJ_UTF8_SURROGATE,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+    CJ_UTF8_CARRY | CJ_UTF8_TOO_LARGE | CJ_UTF8_TOO_LARGE_1000,
+};
+
+// error flags for a byte depending on its own high nibble
+const uint8_t cj_utf8_byte_2_high[16] = {
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_LONG | CJ_UTF8_OVERLONG_2 | CJ_UTF8_TWO_CONTS | CJ_UTF8_OVERLONG_3 | CJ_UTF8_TOO_LARGE_1000 |
+        CJ_UTF8_OVERLONG_4,
+    CJ_UTF8_TOO_LONG | CJ_UTF8_OVERLONG_2 | CJ_UTF8_TWO_CONTS | CJ_UTF8_OVERLONG_3 | CJ_UTF8_TOO_LARGE,
+    CJ_UTF8_TOO_LONG | CJ_UTF8_OVERLONG_2 | CJ_UTF8_TWO_CONTS | CJ_UTF8_SURROGATE | CJ_UTF8_TOO_LARGE,
+    CJ_UTF8_TOO_LONG | CJ_UTF8_OVERLONG_2 | CJ_UTF8_TWO_CONTS | CJ_UTF8_SURROGATE | CJ_UTF8_TOO_LARGE,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+    CJ_UTF8_TOO_SHORT,
+};
+
+/**
+ * Return the bytes of prev and input shifted by n bytes, the bytes n positions before each byte of input.
+ */
+#define CJ_UTF8_PREV(input, prev, n) _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - (n))
+
+// load a 16 entry table into both lanes for _mm256_shuffle_epi8
+#define CJ_UTF8_TABLE(t) _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(t)))
+
+/**
+ * Return a non zero vector if input (following prev) contains invalid or incomplete multibyte sequences. Sequences
+ * continuing into the next block are not reported.
+ */
+__m256i cj_utf8_check_block(__m256i input, __m256i prev) {
+    const __m256i byte_1_high_table = CJ_UTF8_TABLE(cj_utf8_byte_1_high);
+    const __m256i byte_1_low_table = CJ_UTF8_TABLE(cj_utf8_byte_1_low);
+    const __m256i byte_2_high_table = CJ_UTF8_TABLE(cj_utf8_byte_2_high);
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+
+    __m256i prev1 = CJ_UTF8_PREV(input, prev, 1);
+    __m256i byte_1_high =
+        _mm256_shuffle_epi8(byte_1_high_table, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    __m256i byte_1_low = _mm256_shuffle_epi8(byte_1_low_table, _mm256_and_si256(prev1, nibble));
+    __m256i byte_2_high =
+        _mm256_shuffle_epi8(byte_2_high_table, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // third and fourth bytes of three and four byte sequences must be continuations, special_cases marks them with
+    // TWO_CONTS (0x80) and this cancels out for the expected positions
+    __m256i prev2 = CJ_UTF8_PREV(input, prev, 2);
+    __m256i prev3 = CJ_UTF8_PREV(input, prev, 3);
+    __m256i is_third_byte = _mm256_subs_epu8(prev2, _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i is_fourth_byte = _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte),
+                                                    _mm256_set1_epi8((char)0x80));
+    return _mm256_xor_si256(must_be_continuation, special_cases);
+}
+
+/**
+ * Return a non zero vector if the last bytes of input start a sequence which is not complete within input.
+ */
+__m256i cj_utf8_incomplete(__m256i input) {
+    const __m256i max = _mm256_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                         -1, -1, -1, -1, -1, -1, -1, -1, -1, (char)(0xF0 - 1), (char)(0xE0 - 1),
+                                         (char)(0xC0 - 1));
+    return _mm256_subs_epu8(input, max);
+}
+
+bool cj_utf8_valid_avx2(char* p, char* end) {
+    __m256i error = _mm256_setzero_si256();
+    __m256i prev = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    while (p < end) {
+        __m256i input;
+        if (end - p >= 32) {
+            input = _mm256_loadu_si256((const __m256i*)p);
+        } else {
+            // pad the tail with ASCII
+            char tail[32] = {0};
+            memcpy(tail, p, end - p);
+            input = _mm256_loadu_si256((const __m256i*)tail);
+        }
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = _mm256_or_si256(error, prev_incomplete);
+        } else {
+            error = _mm256_or_si256(error, cj_utf8_check_block(input, prev));
+            prev_incomplete = cj_utf8_incomplete(input);
+        }
+        prev = input;
+        p += 32;
+    }
+    error = _mm256_or_si256(error, prev_incomplete);
+    return _mm256_testz_si256(error, error);
+}
+#undef CJ_UTF8_PREV
+#undef CJ_UTF8_TABLE
+#endif
+
+/**
+ * Return a pointer to the first invalid UTF-8 sequence in [p, end) or NULL if all of it is valid.
+ */
+char* cj_utf8_validate(char* p, char* end) {
+#if defined(CJ_SIMD_AVX2)
+    // short strings (most keys) are faster with the scalar loop
+    if (end - p >= 32 && cj_utf8_valid_avx2(p, end)) {
+        return NULL;
+    }
+#endif
+    return cj_utf8_find_invalid(p, end);
+}
+
+/**
+ * Check the whole input if flags contains cj_parse_validate_utf8. Outside of strings only ASCII is valid json, so this
+ * covers the content of all strings with a single pass at the speed of the SIMD kernel. On error *b is moved to the
+ * invalid byte.
+ */
+enum cj_error_code cj_parse_check_utf8(unsigned int flags, char** b, char* end) {
+    if (!(flags & cj_parse_validate_utf8)) {
+        return cj_error_none;
+    }
+    char* invalid = cj_utf8_validate(*b, end);
+    if (invalid != NULL) {
+        *b = invalid;
+        return cj_error_invalid_utf8;
+    }
+    return cj_error_none;
+}
+
+/**
+ * Read the four hexadecimal digits of a \u escape, *b points to the 'u' and is moved past the last digit.
+ */
+enum cj_error_code cj_validate_unicode_escape(char** b, char* end, unsigned int* code_point) {
+    *b = *b + 1;
+    CJ_ERROR_BUBBLE(cj_bytes_available(b, end, 4));
+    *code_point = 0;
+    for (size_t i = 0; i < 4; i++, *b += 1) {
+        if (!(CJ_CC(**b) & CJ_CC_HEX)) {
+            return cj_error_exp_hex;
+        }
+        *code_point = (*code_point << 4) | (CJ_CC(**b) & CJ_CC_HEX_VALUE);
+    }
+    return cj_error_none;
+}
 
-    if (**b != '"') {
+/**
+ * Move *b past the string starting at *b and check its escape sequences, surrogates have to form pairs. *saved is
+ * increased by the number of bytes the escape sequences shrink by when the string is decoded.
+ */
+enum cj_error_code cj_validate_string(char** b, char* end, size_t* saved) {
+    if (CJ_PEEK(b, end) != '"') {
         return cj_error_exp_quote;
     }
-
     *b = *b + 1;
-    value->string.length = *b - value->string.ptr;
-
-    return 0;
-}
-
-struct cj_error cj_parse_object_into(struct cj_parser* parser, char* json, void* object, unsigned int object_type) {
-    char* start = json;
-    char** buffer = &json;
-    struct cj_value value;
-    enum cj_error_code err_type = cj_parse_object(parser, object, object_type, buffer, &value);
-    struct cj_error err = cj_error_new(err_type, start, *buffer);
-    return err;
+
+    while (true) {
+        *b = cj_scan_string(*b, end);
+        if (*b == end) {
+            return cj_error_unexpected_eof;
+        }
+        if (**b == '"') {
+            break;
+        }
+        if (**b != '\\') {
+            return cj_error_control_character;
+        }
+        char* escape = *b;
+        *b = *b + 1;
+        CJ_ERROR_BUBBLE(cj_bytes_available(b, end, 1));
+        if (**b == 'u') {
+            unsigned int code_point;
+            CJ_ERROR_BUBBLE(cj_validate_unicode_escape(b, end, &code_point));
+            if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+                *b = escape;
+                return cj_error_unpaired_surrogate;
+            }
+            if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+                // the low surrogate has to follow, the pair takes 12 bytes escaped and 4 decoded
+                if (end - *b < 2 || (*b)[0] != '\\' || (*b)[1] != 'u') {
+                    *b = escape;
+                    return cj_error_unpaired_surrogate;
+                }
+                *b = *b + 1;
+                CJ_ERROR_BUBBLE(cj_validate_unicode_escape(b, end, &code_point));
+                if (code_point < 0xDC00 || code_point > 0xDFFF) {
+                    *b = escape;
+                    return cj_error_unpaired_surrogate;
+                }
+                *saved += 8;
+            } else {
+                *saved += code_point < 0x80 ? 5 : code_point < 0x800 ? 4 : 3;
+            }
+            continue;
+        }
+        if (!(CJ_CC(**b) & CJ_CC_ESCAPE)) {
+            return cj_error_exp_escaped_character;
+        }
+        *b = *b + 1;
+        *saved += 1;
+    }
+
+    *b = *b + 1;
+    return cj_error_none;
+}
+
+enum cj_error_code cj_parse_string(char** b, char* end, struct cj_value* value) {
+    size_t saved = 0;
+    value->type = cj_type_string;
+    value->string.ptr = *b;
+    value->string.info = 0;
+    CJ_ERROR_BUBBLE(cj_validate_string(b, end, &saved));
+    value->string.length = *b - value->string.ptr;
+    value->string.decoded_length = value->string.length - 2 - saved;
+    value->string.info = cj_span_info_scanned | (saved != 0 ? cj_span_info_escaped : 0);
+
+    return 0;
+}
+
+// Parse context
+//
+// The arena is a list of blocks, allocations bump a pointer in the first block and a full block is followed by one of
+// twice its size. cj_parse_ctx_reset merges the blocks of a document which did not fit into one, so similar documents
+// fit into a single block from then on.
+
+#ifndef CJ_PARSE_CTX_BLOCK
+#define CJ_PARSE_CTX_BLOCK 4096
+#endif
+
+#define CJ_PARSE_CTX_ALIGN _Alignof(max_align_t)
+#define CJ_PARSE_CTX_ROUND(n) (((n) + CJ_PARSE_CTX_ALIGN - 1) & ~(CJ_PARSE_CTX_ALIGN - 1))
+
+struct cj_parse_ctx_block {
+    struct cj_parse_ctx_block* next;
+    size_t size;
+    size_t used;
+};
+
+char* cj_parse_ctx_block_data(struct cj_parse_ctx_block* block) {
+    return (char*)block + CJ_PARSE_CTX_ROUND(sizeof(struct cj_parse_ctx_block));
+}
+
+/**
+ * Put a new block of at least size bytes in front of the arena.
+ */
+bool cj_parse_ctx_grow(struct cj_parse_ctx* ctx, size_t size) {
+    size_t block_size = ctx->blocks == NULL ? CJ_PARSE_CTX_BLOCK : ctx->blocks->size * 2;
+    while (block_size < size) {
+        block_size *= 2;
+    }
+    struct cj_parse_ctx_block* block = malloc(CJ_PARSE_CTX_ROUND(sizeof(struct cj_parse_ctx_block)) + block_size);
+    if (block == NULL) {
+        return false;
+    }
+    *block = (struct cj_parse_ctx_block){.next = ctx->blocks, .size = block_size, .used = 0};
+    ctx->blocks = block;
+    ctx->arena_capacity += block_size;
+    return true;
+}
+
+void cj_parse_ctx_free_blocks(struct cj_parse_ctx* ctx) {
+    struct cj_parse_ctx_block* block = ctx->blocks;
+    while (block != NULL) {
+        struct cj_parse_ctx_block* next = block->next;
+        free(block);
+        block = next;
+    }
+    ctx->blocks = NULL;
+    ctx->arena_capacity = 0;
+}
+
+enum cj_error_code cj_parse_ctx_init(struct cj_parse_ctx* ctx, size_t arena_size) {
+    *ctx = (struct cj_parse_ctx){0};
+    if (arena_size > 0 && !cj_parse_ctx_grow(ctx, arena_size)) {
+        return cj_error_out_of_memory;
+    }
+    return cj_error_none;
+}
+
+void cj_parse_ctx_reset(struct cj_parse_ctx* ctx) {
+    if (ctx->blocks != NULL && ctx->blocks->next != NULL) {
+        size_t capacity = ctx->arena_capacity;
+        cj_parse_ctx_free_blocks(ctx);
+        // if this fails the arena starts over with small blocks
+        cj_parse_ctx_grow(ctx, capacity);
+    } else if (ctx->blocks != NULL) {
+        ctx->blocks->used = 0;
+    }
+}
+
+void cj_parse_ctx_free(struct cj_parse_ctx* ctx) {
+    cj_parse_ctx_free_blocks(ctx);
+    free(ctx->frames);
+    free(ctx->batch);
+    *ctx = (struct cj_parse_ctx){0};
+}
+
+void* cj_parse_ctx_alloc(struct cj_parse_ctx* ctx, size_t size) {
+    size = CJ_PARSE_CTX_ROUND(size);
+    if ((ctx->blocks == NULL || ctx->blocks->size - ctx->blocks->used < size) && !cj_parse_ctx_grow(ctx, size)) {
+        return NULL;
+    }
+    char* ptr = cj_parse_ctx_block_data(ctx->blocks) + ctx->blocks->used;
+    ctx->blocks->used += size;
+    return ptr;
+}
+
+char* cj_parse_ctx_dup(struct cj_parse_ctx* ctx, struct cj_span* span) {
+    assert(span->length >= 2 || (span->info & cj_span_info_decoded));
+    size_t size = span->info & cj_span_info_scanned ? span->decoded_length + 1 : span->length - 1;
+    char* buffer = cj_parse_ctx_alloc(ctx, size);
+    if (buffer != NULL) {
+        cj_span_unescape(span, buffer);
+    }
+    return buffer;
+}
+
+// Container stack
+//
+// Objects and arrays are parsed without recursion. Every open container is a frame on an explicit stack, the first
+// CJ_PARSE_STACK_INLINE frames live inside the stack struct itself, deeper documents move the frames to the heap.
+
+#define CJ_PARSE_STACK_INLINE 32
+
+struct cj_parse_frame {
+    void* this;
+    unsigned int tag;
+    enum cj_container_type type;
+    union cj_key key;
+};
+
+struct cj_parse_stack {
+    struct cj_parse_frame* frames;
+    size_t depth;
+    size_t capacity;
+    size_t max_depth;
+    struct cj_parse_frame inline_frames[CJ_PARSE_STACK_INLINE];
+    // CJ_PUSH_BATCH values collected for parser->push_batch, they always belong to the innermost container. NULL
+    // without push_batch.
+    struct cj_value* batch;
+    size_t batched;
+    // frames on the heap are taken from and returned to the context
+    struct cj_parse_ctx* ctx;
+};
+
+/**
+ * Initialize stack for a document parsed with parser, cj_parse_stack_free has to be called even if this fails.
+ */
+enum cj_error_code cj_parse_stack_init(struct cj_parse_stack* stack, struct cj_parser* parser) {
+    stack->frames = stack->inline_frames;
+    stack->depth = 0;
+    stack->capacity = CJ_PARSE_STACK_INLINE;
+    stack->ctx = parser->ctx;
+    if (stack->ctx != NULL && stack->ctx->frames != NULL) {
+        stack->frames = stack->ctx->frames;
+        stack->capacity = stack->ctx->frames_capacity;
+        stack->ctx->frames = NULL;
+    }
+    stack->max_depth = parser->max_depth == 0 ? CJ_MAX_DEPTH : parser->max_depth;
+    stack->batched = 0;
+    stack->batch = NULL;
+    if (parser->push_batch == NULL) {
+        return cj_error_none;
+    }
+    if (stack->ctx != NULL && stack->ctx->batch != NULL) {
+        stack->batch = stack->ctx->batch;
+        stack->ctx->batch = NULL;
+        return cj_error_none;
+    }
+    stack->batch = malloc(CJ_PUSH_BATCH * sizeof(struct cj_value));
+    return stack->batch == NULL ? cj_error_out_of_memory : cj_error_none;
+}
+
+void cj_parse_stack_free(struct cj_parse_stack* stack) {
+    if (stack->ctx != NULL && stack->batch != NULL) {
+        stack->ctx->batch = stack->batch;
+    } else {
+        free(stack->batch);
+    }
+    if (stack->frames == stack->inline_frames) {
+        return;
+    }
+    if (stack->ctx != NULL) {
+        stack->ctx->frames = stack->frames;
+        stack->ctx->frames_capacity = stack->capacity;
+    } else {
+        free(stack->frames);
+    }
+}
+
+/**
+ * Return cj_error_max_depth if another container can not be opened. Called before parser->open so no callback fires
+ * for a container which is rejected.
+ */
+enum cj_error_code cj_parse_stack_check(struct cj_parse_stack* stack) {
+    if (stack->depth >= stack->max_depth) {
+        return cj_error_max_depth;
+    }
+    return cj_error_none;
+}
+
+enum cj_error_code cj_parse_stack_push(struct cj_parse_stack* stack, void* this, unsigned int tag,
+                                       enum cj_container_type type) {
+    CJ_ERROR_BUBBLE(cj_parse_stack_check(stack));
+    if (stack->depth == stack->capacity) {
+        size_t capacity = stack->capacity * 2;
+        struct cj_parse_frame* frames;
+        if (stack->frames == stack->inline_frames) {
+            frames = malloc(capacity * sizeof(struct cj_parse_frame));
+            if (frames != NULL) {
+                memcpy(frames, stack->inline_frames, sizeof(stack->inline_frames));
+            }
+        } else {
+            frames = realloc(stack->frames, capacity * sizeof(struct cj_parse_frame));
+        }
+        if (frames == NULL) {
+            return cj_error_out_of_memory;
+        }
+        stack->frames = frames;
+        stack->capacity = capacity;
+    }
+    stack->frames[stack->depth++] = (struct cj_parse_frame){.this = this, .tag = tag, .type = type};
+    return cj_error_none;
+}
+
+/**
+ * Hand the values collected for push_batch to the innermost container. Called before a container is opened or closed
+ * so the callbacks see the values in document order.
+ */
+enum cj_error_code cj_parse_stack_flush(struct cj_parser* parser, struct cj_parse_stack* stack) {
+    if (stack->batched == 0) {
+        return cj_error_none;
+    }
+    struct cj_parse_frame* f = &stack->frames[stack->depth - 1];
+    size_t count = stack->batched;
+    stack->batched = 0;
+    return parser->push_batch(f->this, f->tag, f->key.index - count, stack->batch, count);
+}
+
+/**
+ * Hand a parsed value to the container of frame f, the innermost one, set for objects and push or push_batch for
+ * arrays.
+ */
+enum cj_error_code cj_parse_frame_add(struct cj_parser* parser, struct cj_parse_stack* stack, struct cj_parse_frame* f,
+                                      struct cj_value* value) {
+    if (f->type == cj_container_object) {
+        return parser->set(f->this, f->tag, &f->key.id, value);
+    }
+    if (parser->push_batch != NULL && value->type != cj_type_object && value->type != cj_type_array) {
+        stack->batch[stack->batched++] = *value;
+        f->key.index++;
+        if (stack->batched == CJ_PUSH_BATCH) {
+            return cj_parse_stack_flush(parser, stack);
+        }
+        return cj_error_none;
+    }
+    return parser->push(f->this, f->tag, f->key.index++, value);
+}
+
+/**
+ * Parse the run of strings, numbers, booleans and nulls at *b straight into the push_batch buffer of the innermost
+ * container f, an array. Stops behind the last value of the run and leaves the separator after it to the caller.
+ */
+enum cj_error_code cj_parse_array_run(struct cj_parser* parser, struct cj_parse_stack* stack, struct cj_parse_frame* f,
+                                      char** b, char* end) {
+    enum cj_type next;
+    for (;;) {
+        CJ_ERROR_BUBBLE(cj_parse_primitive(b, end, parser->flags, &stack->batch[stack->batched]));
+        stack->batched++;
+        f->key.index++;
+        if (stack->batched == CJ_PUSH_BATCH) {
+            CJ_ERROR_BUBBLE(cj_parse_stack_flush(parser, stack));
+        }
+        char* p = *b;
+        cj_parse_consume_opt_ws(&p, end);
+        if (CJ_PEEK(&p, end) != ',') {
+            return cj_error_none;
+        }
+        p++;
+        cj_parse_consume_opt_ws(&p, end);
+        if (cj_peek_type(&p, end, &next) != cj_error_none || next == cj_type_object || next == cj_type_array) {
+            return cj_error_none;
+        }
+        *b = p;
+    }
+}
+
+enum cj_error_code cj_parse_number_array(struct cj_number_array* array, char** b, char* end);
+
+enum cj_error_code cj_parse_container_walk(struct cj_parser* parser, struct cj_parse_stack* stack, void* root,
+                                           unsigned int root_tag, enum cj_container_type root_type, char** b,
+                                           char* end, struct cj_value* value) {
+    if (root_type == cj_container_object && CJ_PEEK(b, end) != '{') {
+        return cj_error_exp_open_curly_bracket;
+    }
+    if (root_type == cj_container_array && CJ_PEEK(b, end) != '[') {
+        return cj_error_exp_open_square_bracket;
+    }
+    *b = *b + 1;
+    CJ_ERROR_BUBBLE(cj_parse_stack_push(stack, root, root_tag, root_type));
+
+    struct cj_parse_frame* f;
+    struct cj_value child_value;
+    enum cj_type child_type;
+
+open_container:
+    f = &stack->frames[stack->depth - 1];
+    cj_parse_consume_opt_ws(b, end);
+    if (CJ_PEEK(b, end) == (f->type == cj_container_object ? '}' : ']')) {
+        goto close_container;
+    }
+
+next_member:
+    CJ_ERROR_BUBBLE(cj_bytes_available(b, end, 1));
+    if (f->type == cj_container_object) {
+        CJ_ERROR_BUBBLE(cj_parse_id(b, end, parser->flags, &f->key.id));
+        cj_parse_consume_opt_ws(b, end);
+        CJ_ERROR_BUBBLE(cj_consume_colon(b, end));
+        cj_parse_consume_opt_ws(b, end);
+    }
+
+    CJ_ERROR_BUBBLE(cj_peek_type(b, end, &child_type));
+    if (child_type == cj_type_object || child_type == cj_type_array) {
+        enum cj_container_type type = child_type == cj_type_object ? cj_container_object : cj_container_array;
+        void* child;
+        unsigned int child_tag;
+        CJ_ERROR_BUBBLE(cj_parse_stack_check(stack));
+        CJ_ERROR_BUBBLE(cj_parse_stack_flush(parser, stack));
+        enum cj_error_code err = parser->open(type, f->this, f->tag, &f->key, &child, &child_tag);
+        if (err == cj_error_skip) {
+            CJ_ERROR_BUBBLE(cj_skip_container(b, end));
+            goto after_member;
+        }
+        if (err == cj_error_number_array && type == cj_container_array) {
+            CJ_ERROR_BUBBLE(cj_parse_number_array(child, b, end));
+            child_value = (struct cj_value){.type = cj_type_array, .array = child};
+            CJ_ERROR_BUBBLE(cj_parse_frame_add(parser, stack, f, &child_value));
+            goto after_member;
+        }
+        CJ_ERROR_BUBBLE(err);
+        CJ_ERROR_BUBBLE(cj_parse_stack_push(stack, child, child_tag, type));
+        *b = *b + 1;
+        goto open_container;
+    }
+    if (f->type == cj_container_array && parser->push_batch != NULL) {
+        CJ_ERROR_BUBBLE(cj_parse_array_run(parser, stack, f, b, end));
+        goto after_member;
+    }
+    CJ_ERROR_BUBBLE(cj_parse_primitive(b, end, parser->flags, &child_value));
+    CJ_ERROR_BUBBLE(cj_parse_frame_add(parser, stack, f, &child_value));
+
+after_member:
+    cj_parse_consume_opt_ws(b, end);
+    if (cj_consume_comma(b, end) == cj_error_none) {
+        cj_parse_consume_opt_ws(b, end);
+        goto next_member;
+    }
+    if (f->type == cj_container_object && CJ_PEEK(b, end) != '}') {
+        return cj_error_exp_close_curly_bracket;
+    }
+    if (f->type == cj_container_array && CJ_PEEK(b, end) != ']') {
+        return cj_error_exp_close_square_bracket;
+    }
+
+close_container:
+    *b = *b + 1;
+    CJ_ERROR_BUBBLE(cj_parse_stack_flush(parser, stack));
+    value->type = f->type == cj_container_object ? cj_type_object : cj_type_array;
+    value->object = f->this;
+    stack->depth--;
+    if (stack->depth == 0) {
+        return cj_error_none;
+    }
+    f = &stack->frames[stack->depth - 1];
+    CJ_ERROR_BUBBLE(cj_parse_frame_add(parser, stack, f, value));
+    goto after_member;
+}
+
+/**
+ * Parse the object or array at *b and its whole subtree without recursion. Calls the parser callbacks in the same order
+ * as a depth first recursive descent.
+ */
+enum cj_error_code cj_parse_container(struct cj_parser* parser, void* root, unsigned int root_tag,
+                                      enum cj_container_type root_type, char** b, char* end, struct cj_value* value) {
+    struct cj_parse_stack stack;
+    enum cj_error_code err = cj_parse_stack_init(&stack, parser);
+    if (err == cj_error_none) {
+        err = cj_parse_container_walk(parser, &stack, root, root_tag, root_type, b, end, value);
+    }
+    cj_parse_stack_free(&stack);
+    return err;
+}
+
+/**
+ * Parse the container at json with all flags of parser, including cj_parse_insitu.
+ */
+struct cj_error cj_parse_into_n(struct cj_parser* parser, char* json, size_t length, void* container, unsigned int tag,
+                                enum cj_container_type type) {
+    char* end = json + length;
+    char* b = json;
+    struct cj_value value;
+    enum cj_error_code err_type = cj_parse_check_utf8(parser->flags, &b, end);
+    if (err_type == cj_error_none) {
+        err_type = cj_parse_container(parser, container, tag, type, &b, end, &value);
+    }
+    return cj_error_new(err_type, json, b);
+}
+
+/**
+ * Parse with a copy of parser without cj_parse_insitu, only the *_insitu entry points may write to the input.
+ */
+struct cj_error cj_parse_into_const(struct cj_parser* parser, const char* json, size_t length, void* container,
+                                    unsigned int tag, enum cj_container_type type) {
+    if (!(parser->flags & cj_parse_insitu)) {
+        return cj_parse_into_n(parser, (char*)json, length, container, tag, type);
+    }
+    struct cj_parser copy = *parser;
+    copy.flags &= ~cj_parse_insitu;
+    return cj_parse_into_n(&copy, (char*)json, length, container, tag, type);
+}
+
+struct cj_error cj_parse_object_into_n(struct cj_parser* parser, const char* json, size_t length, void* object,
+                                       unsigned int object_type) {
+    return cj_parse_into_const(parser, json, length, object, object_type, cj_container_object);
+}
+
+struct cj_error cj_parse_object_into(struct cj_parser* parser, char* json, void* object, unsigned int object_type) {
+    return cj_parse_object_into_n(parser, json, strlen(json), object, object_type);
+}
+
+struct cj_error cj_parse_object_into_insitu(struct cj_parser* parser, char* json, size_t length, void* object,
+                                            unsigned int object_type) {
+    struct cj_parser copy = *parser;
+    copy.flags |= cj_parse_insitu;
+    return cj_parse_into_n(&copy, json, length, object, object_type, cj_container_object);
+}
+
+enum cj_error_code cj_parse_object(struct cj_parser* parser, void* this, unsigned int this_type, char** b, char* end,
+                                   struct cj_value* value) {
+    return cj_parse_container(parser, this, this_type, cj_container_object, b, end, value);
+}
+
+struct cj_error cj_parse_array_into_n(struct cj_parser* parser, const char* json, size_t length, void* array,
+                                      unsigned int array_type) {
+    return cj_parse_into_const(parser, json, length, array, array_type, cj_container_array);
+}
+
+struct cj_error cj_parse_array_into(struct cj_parser* parser, char* json, void* array, unsigned int array_type) {
+    return cj_parse_array_into_n(parser, json, strlen(json), array, array_type);
+}
+
+struct cj_error cj_parse_array_into_insitu(struct cj_parser* parser, char* json, size_t length, void* array,
+                                           unsigned int array_type) {
+    struct cj_parser copy = *parser;
+    copy.flags |= cj_parse_insitu;
+    return cj_parse_into_n(&copy, json, length, array, array_type, cj_container_array);
+}
+
+enum cj_error_code cj_parse_array(struct cj_parser* parser, void* this, unsigned int this_type, char** b, char* end,
+                                  struct cj_value* value) {
+    return cj_parse_container(parser, this, this_type, cj_container_array, b, end, value);
+}
+
+/**
+ * Move *b past a run of digits.
+ */
+void cj_skip_digits(char** b, char* end) {
+    char* p = *b;
+#if defined(CJ_SWAR_DIGITS)
+    while (end - p >= 8 && cju_is_8_digits(cju_load_8(p))) {
+        p += 8;
+    }
+#endif
+    while (p < end && CJ_IS_DIGIT(*p)) {
+        p++;
+    }
+    *b = p;
+}
+
+/**
+ * Move *b past the number starting at *b. is_decimal is set if the number has a fraction or an exponent.
+ */
+enum cj_error_code cj_validate_number(char** b, char* end, bool* is_decimal) {
+    *is_decimal = false;
+
+    if (CJ_PEEK(b, end) == '-') {
+        *b += 1;
+    }
+
+    if (CJ_PEEK(b, end) == '0') {
+        // no more digits after a leading zero, "01" ends after the "0" like in cj_parse_number
+        *b += 1;
+    } else if (CJ_IS_DIGIT(CJ_PEEK(b, end))) {
+        *b += 1;
+        cj_skip_digits(b, end);
+    } else {
+        return cj_error_exp_digits;
+    }
+
+    if (CJ_PEEK(b, end) == '.') {
+        *is_decimal = true;
+        *b += 1;
+
+        if (CJ_IS_DIGIT(CJ_PEEK(b, end))) {
+            *b += 1;
+        } else {
+            return cj_error_exp_digits;
+        }
+
+        cj_skip_digits(b, end);
+    }
+
+    if (CJ_PEEK(b, end) == 'e' || CJ_PEEK(b, end) == 'E') {
+        *is_decimal = true;
+        *b += 1;
+
+        if (CJ_PEEK(b, end) == '-') {
+            *b += 1;
+        } else if (CJ_PEEK(b, end) == '+') {
+            *b += 1;
+        }
+
+        if (CJ_IS_DIGIT(CJ_PEEK(b, end))) {
+            *b += 1;
+        } else {
+            return cj_error_exp_digits;
+        }
+
+        cj_skip_digits(b, end);
+    }
+
+    return cj_error_none;
+}
+
+/**
+ * Move *b past the number starting at *b and convert it to the nearest double.
+ */
+enum cj_error_code cj_parse_decimal(char** b, char* end, double* value) {
+    char* start = *b;
+    bool negative = CJ_PEEK(b, end) == '-';
+    if (negative) {
+        *b += 1;
+    }
+
+    // the first 19 significant digits always fit into w, the number is w * 10^exponent if none were dropped
+    uint64_t w = 0;
+    int64_t exponent = 0;
+    unsigned int digits = 0;
+    bool truncated = false;
+
+    if (CJ_PEEK(b, end) == '0') {
+        *b += 1;
+    } else if (CJ_IS_DIGIT(CJ_PEEK(b, end))) {
+        char* p = *b;
+#if defined(CJ_SWAR_DIGITS)
+        while (digits + 8 <= 19 && end - p >= 8 && cju_is_8_digits(cju_load_8(p))) {
+            w = w * 100000000 + cju_parse_8_digits(cju_load_8(p));
+            digits += 8;
+            p += 8;
+        }
+#endif
+        for (; p < end && CJ_IS_DIGIT(*p); p++) {
+            unsigned int digit = *p - '0';
+            if (digits < 19) {
+                w = w * 10 + digit;
+                digits++;
+            } else {
+                exponent++;
+                truncated |= digit != 0;
+            }
+        }
+        *b = p;
+    } else {
+        return cj_error_exp_digits;
+    }
+
+    if (CJ_PEEK(b, end) == '.') {
+        *b += 1;
+        if (!CJ_IS_DIGIT(CJ_PEEK(b, end))) {
+            return cj_error_exp_digits;
+        }
+        char* p = *b;
+#if defined(CJ_SWAR_DIGITS)
+        // leading zeros of the fraction are not significant, leave them to the scalar loop
+        while (w != 0 && digits + 8 <= 19 && end - p >= 8 && cju_is_8_digits(cju_load_8(p))) {
+            w = w * 100000000 + cju_parse_8_digits(cju_load_8(p));
+            digits += 8;
+            exponent -= 8;
+            p += 8;
+        }
+#endif
+        for (; p < end && CJ_IS_DIGIT(*p); p++) {
+            unsigned int digit = *p - '0';
+            if (digits < 19) {
+                w = w * 10 + digit;
+                exponent--;
+                digits += w != 0;
+            } else {
+                truncated |= digit != 0;
+            }
+        }
+        *b = p;
+    }
+
+    if (CJ_PEEK(b, end) == 'e' || CJ_PEEK(b, end) == 'E') {
+        *b += 1;
+        bool negative_exponent = CJ_PEEK(b, end) == '-';
+        if (CJ_PEEK(b, end) == '-' || CJ_PEEK(b, end) == '+') {
+            *b += 1;
+        }
+        if (!CJ_IS_DIGIT(CJ_PEEK(b, end))) {
+            return cj_error_exp_digits;
+        }
+        int64_t e = 0;
+        while (CJ_IS_DIGIT(CJ_PEEK(b, end))) {
+            if (e < 100000) {
+                e = e * 10 + (**b - '0');
+            }
+            *b += 1;
+        }
+        exponent += negative_exponent ? -e : e;
+    }
+
+    if (w == 0) {
+        *value = negative ? -0.0 : 0.0;
+        return cj_error_none;
+    }
+
+#if FLT_EVAL_METHOD == 0
+    // both w and 10^exponent are exact doubles, a single operation rounds correctly
+    if (!truncated && w <= (1ULL << 53) && exponent >= -22 && exponent <= 22) {
+        double d = (double)w;
+        d = exponent < 0 ? d / cju_pow10_exact[-exponent] : d * cju_pow10_exact[exponent];
+        *value = negative ? -d : d;
+        return cj_error_none;
+    }
+#endif
+
+    // with dropped digits the number lies between w and w + 1, both must round to the same double
+    double rounded;
+    if (cju_eisel_lemire(w, exponent, negative, value) &&
+        (!truncated || (cju_eisel_lemire(w + 1, exponent, negative, &rounded) && rounded == *value))) {
+        return cj_error_none;
+    }
+
+    *value = cju_decimal_to_double(start, *b);
+    return cj_error_none;
+}
+
+/**
+ * Integers are accumulated while their digits are scanned and stored in the narrowest cj_numeric type that holds them.
+ * Only numbers with a fraction, an exponent or more than 64 bits are scanned again by cj_parse_decimal.
+ */
+enum cj_error_code cj_parse_number(char** b, char* end, struct cj_value* value) {
+    char* start = *b;
+    bool negative = CJ_PEEK(b, end) == '-';
+    if (negative) {
+        *b += 1;
+    }
+
+    // the magnitude of the integer, negative values must fit into int64_t, positive ones into uint64_t
+    uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : UINT64_MAX;
+    uint64_t integer = 0;
+    bool overflow = false;
+
+    if (CJ_PEEK(b, end) == '0') {
+        *b += 1;
+    } else if (CJ_IS_DIGIT(CJ_PEEK(b, end))) {
+        // a local cursor keeps the digit loops free of stores through b
+        char* p = *b;
+#if defined(CJ_SWAR_DIGITS)
+        // eight digits at a time while the result surely fits into int64_t, the scalar loop below finishes the number
+        // and finds the exact point of overflow
+        while (integer < INT64_MAX / 100000000 && end - p >= 8 && cju_is_8_digits(cju_load_8(p))) {
+            integer = integer * 100000000 + cju_parse_8_digits(cju_load_8(p));
+            p += 8;
+        }
+#endif
+        while (p < end && CJ_IS_DIGIT(*p)) {
+            uint64_t digit = *p - '0';
+            if (integer > (limit - digit) / 10) {
+                overflow = true;
+                break;
+            }
+            integer = integer * 10 + digit;
+            p++;
+        }
+        *b = p;
+    } else {
+        return cj_error_exp_digits;
+    }
+
+    value->type = cj_type_number;
+
+    char c = CJ_PEEK(b, end);
+    if (!overflow && c != '.' && c != 'e' && c != 'E') {
+        if (negative) {
+            int64_t v = integer == 0 ? 0 : -(int64_t)(integer - 1) - 1;
+            value->number = v >= INT_MIN ? cj_numeric_integer(v) : cj_numeric_integer64(v);
+        } else if (integer <= INT_MAX) {
+            value->number = cj_numeric_integer(integer);
+        } else if (integer <= INT64_MAX) {
+            value->number = cj_numeric_integer64(integer);
+        } else {
+            value->number = cj_numeric_uinteger64(integer);
+        }
+        return cj_error_none;
+    }
+
+    double decimal;
+    *b = start;
+    CJ_ERROR_BUBBLE(cj_parse_decimal(b, end, &decimal));
+    value->number = cj_numeric_decimal64(decimal);
+
+    return cj_error_none;
+}
+
+/**
+ * Like cj_parse_number but only validates the number and stores its text.
+ */
+enum cj_error_code cj_parse_number_span(char** b, char* end, struct cj_value* value) {
+    bool is_decimal;
+    char* start = *b;
+
+    CJ_ERROR_BUBBLE(cj_validate_number(b, end, &is_decimal));
+
+    value->type = cj_type_number;
+    value->number.type = is_decimal ? cj_numeric_type_decimal_span : cj_numeric_type_integer_span;
+    value->number.text.ptr = start;
+    value->number.text.length = *b - start;
+    return cj_error_none;
+}
+
+enum cj_error_code cj_numeric_from_text(const char* text, size_t length, struct cj_numeric* out) {
+    struct cj_value value;
+    char* b = (char*)text;
+    char* end = b + length;
+    CJ_ERROR_BUBBLE(cj_parse_number(&b, end, &value));
+    if (b != end) {
+        return cj_error_unexpected_input;
+    }
+    *out = value.number;
+    return cj_error_none;
+}
+
+enum cj_error_code cj_parse_bool(char** b, char* end, struct cj_value* value) {
+    CJ_ERROR_BUBBLE(cj_bytes_available(b, end, 4));
+    if (memcmp(*b, "true", 4) == 0) {
+        value->type = cj_type_bool;
+        value->boolean = true;
+        *b = *b + 4;
+        return cj_error_none;
+    }
+
+    CJ_ERROR_BUBBLE(cj_bytes_available(b, end, 5));
+    if (memcmp(*b, "false", 5) == 0) {
+        value->type = cj_type_bool;
+        value->boolean = false;
+        *b = *b + 5;
+        return cj_error_none;
+    }
+
+    return cj_error_exp_value;
+}
+
+enum cj_error_code cj_parse_null(char** b, char* end, struct cj_value* value) {
+    CJ_ERROR_BUBBLE(cj_bytes_available(b, end, 4));
+    if (memcmp(*b, "null", 4) == 0) {
+        value->type = cj_type_null;
+        *b = *b + 4;
+        return cj_error_none;
+    }
+
+    return cj_error_exp_value;
+}
+
+// Validate
+
+/**
+ * Check the json value at *b. The kind of every open container is kept in a bit set, so nesting needs no memory
+ * besides CJ_MAX_DEPTH bits on the stack.
+ */
+enum cj_error_code cj_validate_value(char** b, char* end) {
+    uint64_t objects[CJ_MAX_DEPTH / 64 + 1];
+    size_t depth = 0;
+    bool is_decimal;
+    // decoded lengths are not needed to validate
+    size_t saved = 0;
+
+// true if the innermost open container is an object
+#define CJ_VALIDATE_IN_OBJECT() ((objects[(depth - 1) / 64] >> ((depth - 1) % 64)) & 1)
+
+value:
+    switch (CJ_PEEK(b, end)) {
+        case '{':
+        case '[':
+            if (depth == CJ_MAX_DEPTH) {
+                return cj_error_max_depth;
+            }
+            if (**b == '{') {
+                objects[depth / 64] |= 1ULL << (depth % 64);
+            } else {
+                objects[depth / 64] &= ~(1ULL << (depth % 64));
+            }
+            depth++;
+            *b = *b + 1;
+            cj_parse_consume_opt_ws(b, end);
+            if (CJ_PEEK(b, end) == (CJ_VALIDATE_IN_OBJECT() ? '}' : ']')) {
+                *b = *b + 1;
+                depth--;
+                goto after_value;
+            }
+            goto member;
+        case '"':
+            CJ_ERROR_BUBBLE(cj_validate_string(b, end, &saved));
+            break;
+        case 't':
+        case 'n':
+            CJ_ERROR_BUBBLE(cj_bytes_available(b, end, 4));
+            if (memcmp(*b, **b == 't' ? "true" : "null", 4) != 0) {
+                return cj_error_exp_value;
+            }
+            *b = *b + 4;
+            break;
+        case 'f':
+            CJ_ERROR_BUBBLE(cj_bytes_available(b, end, 5));
+            if (memcmp(*b, "false", 5) != 0) {
+                return cj_error_exp_value;
+            }
+            *b = *b + 5;
+            break;
+        default:
+            if (CJ_PEEK(b, end) != '-' && !CJ_IS_DIGIT(CJ_PEEK(b, end))) {
+                return cj_error_exp_value;
+            }
+            CJ_ERROR_BUBBLE(cj_validate_number(b, end, &is_decimal));
+            break;
+    }
+
+after_value:
+    if (depth == 0) {
+        return cj_error_none;
+    }
+    cj_parse_consume_opt_ws(b, end);
+    if (CJ_PEEK(b, end) == ',') {
+        *b = *b + 1;
+        cj_parse_consume_opt_ws(b, end);
+        goto member;
+    }
+    if (CJ_VALIDATE_IN_OBJECT()) {
+        if (CJ_PEEK(b, end) != '}') {
+            return cj_error_exp_close_curly_bracket;
+        }
+    } else if (CJ_PEEK(b, end) != ']') {
+        return cj_error_exp_close_square_bracket;
+    }
+    *b = *b + 1;
+    depth--;
+    goto after_value;
+
+member:
+    CJ_ERROR_BUBBLE(cj_bytes_available(b, end, 1));
+    if (CJ_VALIDATE_IN_OBJECT()) {
+        CJ_ERROR_BUBBLE(cj_validate_string(b, end, &saved));
+        cj_parse_consume_opt_ws(b, end);
+        CJ_ERROR_BUBBLE(cj_consume_colon(b, end));
+        cj_parse_consume_opt_ws(b, end);
+    }
+    goto value;
+#undef CJ_VALIDATE_IN_OBJECT
 }
 
-enum cj_error_code cj_parse_object(struct cj_parser* parser, void* this, unsigned int this_type, char** b,
-                                   struct cj_value* value) {
-    if (**b != '{') {
-        return cj_error_exp_open_curly_bracket;
+bool cj_validate(const char* json, size_t length, struct cj_error* error) {
+    char* start = (char*)json;
+    char* end = start + length;
+    char* b = start;
+
+    cj_parse_consume_opt_ws(&b, end);
+    enum cj_error_code err = cj_validate_value(&b, end);
+    if (err == cj_error_none) {
+        cj_parse_consume_opt_ws(&b, end);
+        if (b != end) {
+            err = cj_error_unexpected_input;
+        }
     }
-    *b = *b + 1;
 
-    value->type = cj_type_object;
-    value->object = this;
-    union cj_key key;
-
-    while (**b != '}') {
-        CJ_ERROR_BUBBLE(cj_bytes_available(b, 1));
-
-        enum cj_type child_type;
-        struct cj_value child_value;
-
-        cj_parse_consume_opt_ws(b);
-        CJ_ERROR_BUBBLE(cj_parse_id(b, &key.id));
-        cj_parse_consume_opt_ws(b);
-        CJ_ERROR_BUBBLE(cj_consume_colon(b));
-        cj_parse_consume_opt_ws(b);
-
-        CJ_ERROR_BUBBLE(cj_peek_type(b, &child_type));
-        switch (child_type) {
-            case cj_type_object:
-                void* object;
-                unsigned int object_type;
-                CJ_ERROR_BUBBLE(parser->open(cj_container_object, this, this_type, &key, &object, &object_type));
-                CJ_ERROR_BUBBLE(cj_parse_object(parser, object, object_type, b, &child_value));
-                CJ_ERROR_BUBBLE(parser->set(this, this_type, &key.id, &child_value));
-                break;
-            case cj_type_array:
-                void* array;
-                unsigned int array_type;
-                CJ_ERROR_BUBBLE(parser->open(cj_container_array, this, this_type, &key, &array, &array_type));
-                CJ_ERROR_BUBBLE(cj_parse_array(parser, array, array_type, b, &child_value));
-                CJ_ERROR_BUBBLE(parser->set(this, this_type, &key.id, &child_value));
-                break;
-            default:
-                CJ_ERROR_BUBBLE(cj_parse_primitive(b, &child_value));
-                CJ_ERROR_BUBBLE(parser->set(this, this_type, &key.id, &child_value));
-                break;
+    if (error != NULL) {
+        if (err == cj_error_none) {
+            // computing line and column walks the whole input, which is only worth it for errors
+            *error = (struct cj_error){.type = cj_error_none};
+        } else {
+            *error = cj_error_new(err, start, b);
         }
+    }
+    return err == cj_error_none;
+}
 
-        cj_parse_consume_opt_ws(b);
+// Binding
+//
+// cj_parse_bound writes values directly into structs described by cj_field lists. Keys are looked up with the
+// cj_key_matcher of each binding. Nesting is followed with recursion, the depth is limited to CJ_MAX_DEPTH.
 
-        if (cj_consume_comma(b) == cj_error_none) {
-            continue;
-        } else {
-            // no "," found object is done, expecting "}"
-            break;
-        }
+/**
+ * Check the parts of field cj_bind_value relies on, the elements of arrays included.
+ */
+enum cj_error_code cj_field_check(const struct cj_field* field) {
+    while (field->type == cj_field_array) {
+        field = field->element;
     }
+    return field->type == cj_field_chars && field->size == 0 ? cj_error_invalid_field : cj_error_none;
+}
 
-    if (**b != '}') {
-        return cj_error_exp_close_curly_bracket;
+enum cj_error_code cj_binding_init(struct cj_binding* binding, const struct cj_field* fields, size_t count) {
+    *binding = (struct cj_binding){.fields = fields, .count = count};
+    for (size_t i = 0; i < count; i++) {
+        CJ_ERROR_BUBBLE(cj_field_check(&fields[i]));
     }
-    *b = *b + 1;
+    binding->keys = malloc((count > 0 ? count : 1) * sizeof(char*));
+    if (binding->keys == NULL) {
+        return cj_error_out_of_memory;
+    }
+    for (size_t i = 0; i < count; i++) {
+        binding->keys[i] = fields[i].key;
+    }
+    enum cj_error_code err = cj_key_matcher_init(&binding->matcher, binding->keys, count);
+    if (err != cj_error_none) {
+        free(binding->keys);
+        binding->keys = NULL;
+    }
+    return err;
+}
 
-    return 0;
+void cj_binding_free(struct cj_binding* binding) {
+    cj_key_matcher_free(&binding->matcher);
+    free(binding->keys);
+    binding->keys = NULL;
 }
 
-struct cj_error cj_parse_array_into(struct cj_parser* parser, char* json, void* array, unsigned int array_type) {
-    char* start = json;
-    char** buffer = &json;
-    struct cj_value value;
-    enum cj_error_code err_type = cj_parse_array(parser, array, array_type, buffer, &value);
-    struct cj_error err = cj_error_new(err_type, start, *buffer);
-    return err;
+/**
+ * Store a parsed number in a field of type type, fails if the number does not fit.
+ */
+enum cj_error_code cj_bind_number(enum cj_field_type type, struct cj_numeric* n, char* dst) {
+    bool negative = (n->type == cj_numeric_type_integer && n->integer < 0) ||
+                    (n->type == cj_numeric_type_integer64 && n->integer64 < 0);
+    switch (type) {
+        case cj_field_int:
+            if (n->type != cj_numeric_type_integer) {
+                return cj_error_type_mismatch;
+            }
+            *(int*)dst = n->integer;
+            return cj_error_none;
+        case cj_field_int64:
+            if (n->type == cj_numeric_type_integer) {
+                *(int64_t*)dst = n->integer;
+            } else if (n->type == cj_numeric_type_integer64) {
+                *(int64_t*)dst = n->integer64;
+            } else {
+                return cj_error_type_mismatch;
+            }
+            return cj_error_none;
+        case cj_field_uint64:
+            if (negative) {
+                return cj_error_type_mismatch;
+            }
+            if (n->type == cj_numeric_type_integer) {
+                *(uint64_t*)dst = n->integer;
+            } else if (n->type == cj_numeric_type_integer64) {
+                *(uint64_t*)dst = n->integer64;
+            } else if (n->type == cj_numeric_type_uinteger64) {
+                *(uint64_t*)dst = n->uinteger64;
+            } else {
+                return cj_error_type_mismatch;
+            }
+            return cj_error_none;
+        case cj_field_double:
+            if (n->type == cj_numeric_type_integer) {
+                *(double*)dst = n->integer;
+            } else if (n->type == cj_numeric_type_integer64) {
+                *(double*)dst = n->integer64;
+            } else if (n->type == cj_numeric_type_uinteger64) {
+                *(double*)dst = n->uinteger64;
+            } else {
+                *(double*)dst = n->decimal64;
+            }
+            return cj_error_none;
+        default:
+            return cj_error_type_mismatch;
+    }
 }
 
-enum cj_error_code cj_parse_array(struct cj_parser* parser, void* this, unsigned int this_type, char** b,
-                                  struct cj_value* value) {
-    assert(**b == '[');
-    *b = *b + 1;
+enum cj_error_code cj_bind_object(const struct cj_binding* binding, char** b, char* end, char* out, size_t depth);
+enum cj_error_code cj_bind_value(const struct cj_field* field, char** b, char* end, char* base, size_t depth);
+void cj_bound_free_field(const struct cj_field* field, char* base);
 
-    value->type = cj_type_array;
-    value->object = this;
-    union cj_key key;
-    key.index = 0;
-
-    while (**b != ']') {
-        enum cj_type child_type;
-        struct cj_value child_value;
-
-        cj_parse_consume_opt_ws(b);
-
-        cj_peek_type(b, &child_type);
-        switch (child_type) {
-            case cj_type_object:
-                void* object;
-                unsigned int object_type;
-                CJ_ERROR_BUBBLE(parser->open(cj_container_object, this, this_type, &key, &object, &object_type));
-                CJ_ERROR_BUBBLE(cj_parse_object(parser, object, object_type, b, &child_value));
-                CJ_ERROR_BUBBLE(parser->push(this, this_type, key.index++, &child_value));
-                break;
-            case cj_type_array:
-                void* array;
-                unsigned int array_type;
-                CJ_ERROR_BUBBLE(parser->open(cj_container_array, this, this_type, &key, &array, &array_type));
-                CJ_ERROR_BUBBLE(cj_parse_array(parser, array, array_type, b, &child_value));
-                CJ_ERROR_BUBBLE(parser->push(this, this_type, key.index++, &child_value));
-                break;
-            default:
-                CJ_ERROR_BUBBLE(cj_parse_primitive(b, &child_value));
-                CJ_ERROR_BUBBLE(parser->push(this, this_type, key.index++, &child_value));
-                break;
+/**
+ * Parse the items of the array at *b, which points to its '[', into dst and count them in *count.
+ */
+enum cj_error_code cj_bind_array(const struct cj_field* field, char** b, char* end, char* dst, size_t* count,
+                                 size_t depth) {
+    *b = *b + 1;
+    cj_parse_consume_opt_ws(b, end);
+    if (CJ_PEEK(b, end) == ']') {
+        *b = *b + 1;
+        return cj_error_none;
+    }
+    while (true) {
+        if (*count == field->capacity) {
+            return cj_error_array_capacity;
         }
-        cj_parse_consume_opt_ws(b);
-        if (cj_consume_comma(b) == cj_error_none) {
+        CJ_ERROR_BUBBLE(cj_bind_value(field->element, b, end, dst + *count * field->size, depth + 1));
+        *count += 1;
+        cj_parse_consume_opt_ws(b, end);
+        if (cj_consume_comma(b, end) == cj_error_none) {
+            cj_parse_consume_opt_ws(b, end);
             continue;
-        } else {
-            break;
         }
+        if (CJ_PEEK(b, end) != ']') {
+            return cj_error_exp_close_square_bracket;
+        }
+        *b = *b + 1;
+        return cj_error_none;
     }
-    if (**b != ']') {
-        return cj_error_exp_close_square_bracket;
-    }
-    *b = *b + 1;
-
-    return 0;
 }
 
-#define MOVE_NEXT_OR_ERROR(cpp) \
-    *cpp += 1;                  \
-    CJ_ERROR_BUBBLE(cj_input_ready(cpp, 1))
-
-enum cj_error_code cj_parse_number(char** b, struct cj_value* value) {
-    bool is_decimal = false;
+/**
+ * Parse the value at *b into the field of the struct at base.
+ */
+enum cj_error_code cj_bind_value(const struct cj_field* field, char** b, char* end, char* base, size_t depth) {
+    char* dst = base + field->offset;
     char* start = *b;
+    enum cj_type type;
+    struct cj_value value;
 
-    if (**b == '-') {
-        *b += 1;
-        if (**b == '\0') {
-            return cj_error_exp_digits;
-        }
+    CJ_ERROR_BUBBLE(cj_peek_type(b, end, &type));
+    if (type == cj_type_null) {
+        return cj_parse_null(b, end, &value);
     }
 
-    if (**b == '0') {
-        *b += 1;
-    } else if (**b >= '1' && **b <= '9') {
-        *b += 1;
-    } else {
-        return cj_error_exp_digits;
+    switch (field->type) {
+        case cj_field_object:
+            if (type != cj_type_object) {
+                return cj_error_type_mismatch;
+            }
+            return cj_bind_object(field->binding, b, end, dst, depth + 1);
+        case cj_field_array:
+            if (type != cj_type_array) {
+                return cj_error_type_mismatch;
+            }
+            if (depth + 1 >= CJ_MAX_DEPTH) {
+                return cj_error_max_depth;
+            }
+            size_t* count = (size_t*)(base + field->count_offset);
+            size_t old_count = *count;
+            *count = 0;
+            enum cj_error_code err = cj_bind_array(field, b, end, dst, count, depth);
+            // a repeated key leaves fewer items, free the ones past the new count and the one which failed
+            size_t stale = err != cj_error_none && *count < field->capacity ? *count + 1 : *count;
+            stale = stale > old_count ? stale : old_count;
+            for (size_t i = *count; i < stale; i++) {
+                cj_bound_free_field(field->element, dst + i * field->size);
+            }
+            return err;
+        case cj_field_bool:
+            if (type != cj_type_bool) {
+                return cj_error_type_mismatch;
+            }
+            CJ_ERROR_BUBBLE(cj_parse_bool(b, end, &value));
+            *(bool*)dst = value.boolean;
+            return cj_error_none;
+        case cj_field_string:
+        case cj_field_chars:
+            if (type != cj_type_string) {
+                return cj_error_type_mismatch;
+            }
+            CJ_ERROR_BUBBLE(cj_parse_string(b, end, &value));
+            if (field->type == cj_field_chars) {
+                cj_span_cpy(&value.string, dst, field->size);
+                return cj_error_none;
+            }
+            // a repeated key replaces the string
+            free(*(char**)dst);
+            *(char**)dst = cj_span_dup(&value.string);
+            return *(char**)dst == NULL ? cj_error_out_of_memory : cj_error_none;
+        default:
+            if (type != cj_type_number) {
+                return cj_error_type_mismatch;
+            }
+            CJ_ERROR_BUBBLE(cj_parse_number(b, end, &value));
+            if (cj_bind_number(field->type, &value.number, dst) != cj_error_none) {
+                *b = start;
+                return cj_error_type_mismatch;
+            }
+            return cj_error_none;
     }
+}
 
-    while (**b >= '0' && **b <= '9') {
-        *b += 1;
+/**
+ * Parse the object at *b into the struct at out.
+ */
+enum cj_error_code cj_bind_object(const struct cj_binding* binding, char** b, char* end, char* out, size_t depth) {
+    if (depth >= CJ_MAX_DEPTH) {
+        return cj_error_max_depth;
     }
-
-    if (**b == '.') {
-        is_decimal = true;
-        *b += 1;
-
-        if (**b >= '0' && **b <= '9') {
-            *b += 1;
-        } else {
-            return cj_error_exp_digits;
-        }
-
-        while (**b >= '0' && **b <= '9') {
-            *b += 1;
-        }
+    if (CJ_PEEK(b, end) != '{') {
+        return cj_error_exp_open_curly_bracket;
+    }
+    *b = *b + 1;
+    cj_parse_consume_opt_ws(b, end);
+    if (CJ_PEEK(b, end) == '}') {
+        *b = *b + 1;
+        return cj_error_none;
     }
 
-    if (**b == 'e' || **b == 'E') {
-        is_decimal = true;
-        *b += 1;
-
-        if (**b == '-') {
-            *b += 1;
-        } else if (**b == '+') {
-            *b += 1;
-        }
+    while (true) {
+        struct cj_span id;
+        CJ_ERROR_BUBBLE(cj_parse_id(b, end, 0, &id));
+        cj_parse_consume_opt_ws(b, end);
+        CJ_ERROR_BUBBLE(cj_consume_colon(b, end));
+        cj_parse_consume_opt_ws(b, end);
 
-        if (**b >= '0' && **b <= '9') {
-            *b += 1;
+        int index = cj_key_matcher_find(&binding->matcher, &id);
+        if (index == -1) {
+            CJ_ERROR_BUBBLE(cj_validate_value(b, end));
         } else {
-            return cj_error_exp_digits;
+            CJ_ERROR_BUBBLE(cj_bind_value(&binding->fields[index], b, end, out, depth));
         }
 
-        while (**b >= '0' && **b <= '9') {
-            *b += 1;
+        cj_parse_consume_opt_ws(b, end);
+        if (cj_consume_comma(b, end) == cj_error_none) {
+            cj_parse_consume_opt_ws(b, end);
+            continue;
         }
+        if (CJ_PEEK(b, end) != '}') {
+            return cj_error_exp_close_curly_bracket;
+        }
+        *b = *b + 1;
+        return cj_error_none;
     }
+}
 
-    size_t len = *b - start;
-    char number_str[len + 1];
-    memset(number_str, 0, len + 1);
-    memcpy(number_str, start, len);
+struct cj_error cj_parse_bound(const struct cj_binding* binding, const char* json, size_t length, void* out) {
+    char* start = (char*)json;
+    char* end = start + length;
+    char* b = start;
 
-    value->type = cj_type_number;
+    cj_parse_consume_opt_ws(&b, end);
+    enum cj_error_code err = cj_bind_object(binding, &b, end, out, 0);
+    if (err == cj_error_none) {
+        // line and column are only computed for errors
+        return (struct cj_error){.type = cj_error_none, .data = start, .stopped_at = b};
+    }
+    return cj_error_new(err, start, b);
+}
 
-    if(is_decimal){
-        value->number = cj_numeric_decimal(atof(number_str));
-    } else {
-        value->number = cj_numeric_integer(atoi(number_str));
+/**
+ * Free the strings of the field of the struct at base.
+ */
+void cj_bound_free_field(const struct cj_field* field, char* base) {
+    char* dst = base + field->offset;
+    switch (field->type) {
+        case cj_field_string:
+            free(*(char**)dst);
+            *(char**)dst = NULL;
+            break;
+        case cj_field_object:
+            cj_bound_free(field->binding, dst);
+            break;
+        case cj_field_array:
+            size_t count = *(size_t*)(base + field->count_offset);
+            for (size_t i = 0; i < count; i++) {
+                cj_bound_free_field(field->element, dst + i * field->size);
+            }
+            break;
+        default:
+            break;
     }
+}
 
-    return cj_error_none;
+void cj_bound_free(const struct cj_binding* binding, void* out) {
+    for (size_t i = 0; i < binding->count; i++) {
+        cj_bound_free_field(&binding->fields[i], out);
+    }
 }
 
-enum cj_error_code cj_parse_bool(char** b, struct cj_value* value) {
-    CJ_ERROR_BUBBLE(cj_bytes_available(b, 4));
-    if (memcmp(*b, "true", 4) == 0) {
-        value->type = cj_type_bool;
-        value->boolean = true;
-        *b = *b + 4;
+// Number arrays
+//
+// Arrays of numbers are parsed straight into a caller provided buffer, the conversion of cj_parse_bound is reused for
+// every element.
+
+/**
+ * Parse the array of numbers at *b, which points to its '[', into array.
+ */
+enum cj_error_code cj_parse_number_array(struct cj_number_array* array, char** b, char* end) {
+    enum cj_field_type field = array->type == cj_number_array_int64 ? cj_field_int64 : cj_field_double;
+    size_t size = array->type == cj_number_array_int64 ? sizeof(int64_t) : sizeof(double);
+    char* dst = array->values;
+    struct cj_value value;
+    enum cj_type type;
+
+    array->count = 0;
+    *b = *b + 1;
+    cj_parse_consume_opt_ws(b, end);
+    if (CJ_PEEK(b, end) == ']') {
+        *b = *b + 1;
         return cj_error_none;
     }
-
-    CJ_ERROR_BUBBLE(cj_bytes_available(b, 5));
-    if (memcmp(*b, "false", 5) == 0) {
-        value->type = cj_type_bool;
-        value->boolean = false;
-        *b = *b + 5;
+    for (;;) {
+        CJ_ERROR_BUBBLE(cj_peek_type(b, end, &type));
+        if (type != cj_type_number) {
+            return cj_error_type_mismatch;
+        }
+        if (array->count == array->capacity) {
+            return cj_error_array_capacity;
+        }
+        char* number = *b;
+        CJ_ERROR_BUBBLE(cj_parse_number(b, end, &value));
+        if (cj_bind_number(field, &value.number, dst + array->count * size) != cj_error_none) {
+            *b = number;
+            return cj_error_type_mismatch;
+        }
+        array->count++;
+        cj_parse_consume_opt_ws(b, end);
+        if (cj_consume_comma(b, end) == cj_error_none) {
+            cj_parse_consume_opt_ws(b, end);
+            continue;
+        }
+        if (CJ_PEEK(b, end) != ']') {
+            return cj_error_exp_close_square_bracket;
+        }
+        *b = *b + 1;
         return cj_error_none;
     }
-
-    return cj_error_exp_value;
 }
 
-enum cj_error_code cj_parse_null(char** b, struct cj_value* value) {
-    CJ_ERROR_BUBBLE(cj_bytes_available(b, 4));
-    if (memcmp(*b, "null", 4) == 0) {
-        value->type = cj_type_null;
-        *b = *b + 4;
-        return cj_error_none;
-    }
+struct cj_error cj_parse_number_array_into(const char* json, size_t length, struct cj_number_array* array) {
+    char* start = (char*)json;
+    char* end = start + length;
+    char* b = start;
 
-    return cj_error_exp_value;
+    array->count = 0;
+    cj_parse_consume_opt_ws(&b, end);
+    if (CJ_PEEK(&b, end) != '[') {
+        return cj_error_new(cj_error_exp_open_square_bracket, start, b);
+    }
+    enum cj_error_code err = cj_parse_number_array(array, &b, end);
+    if (err == cj_error_none) {
+        return (struct cj_error){.type = cj_error_none, .data = start, .stopped_at = b};
+    }
+    return cj_error_new(err, start, b);
 }
 
 // Decode
@@ -1351,41 +4450,95 @@ size_t cj_entity_length(struct cj_entity* e) {
     return l;
 }
 
-void cj_entity_free(struct cj_entity* e) {
+void cj_entity_free_tree(struct cj_entity* e, bool free_strings) {
     assert(e != NULL);
 
     if (e->first != NULL) {
-        cj_entity_free(e->first);
+        cj_entity_free_tree(e->first, free_strings);
     }
 
     if (e->next != NULL) {
-        cj_entity_free(e->next);
+        cj_entity_free_tree(e->next, free_strings);
     }
 
-    if (e->type == cj_type_string && e->string != NULL) {
+    if (free_strings && e->type == cj_type_string && e->string != NULL) {
         free(e->string);
     }
 
-    if (e->parent_type == cj_entity_parent_object && e->id != NULL) {
+    if (free_strings && e->parent_type == cj_entity_parent_object && e->id != NULL) {
         free(e->id);
     }
 
     free(e);
 }
 
+void cj_entity_free(struct cj_entity* e) {
+    cj_entity_free_tree(e, true);
+}
+
+void cj_entity_free_insitu(struct cj_entity* e) {
+    cj_entity_free_tree(e, false);
+}
+
+/**
+ * An object or array while it is decoded, ctx is the context its children are allocated from (NULL for malloc).
+ */
+struct cj_entity_container {
+    struct cj_entity entity;
+    struct cj_parse_ctx* ctx;
+};
+
+/**
+ * Allocate size zeroed bytes from ctx or with calloc if ctx is NULL.
+ */
+void* cj_entity_alloc(struct cj_parse_ctx* ctx, size_t size) {
+    if (ctx == NULL) {
+        return calloc(1, size);
+    }
+    void* e = cj_parse_ctx_alloc(ctx, size);
+    if (e != NULL) {
+        memset(e, 0, size);
+    }
+    return e;
+}
+
+/**
+ * Return the string of a decoded entity, strings decoded in place are used as they are.
+ */
+char* cj_entity_string(struct cj_parse_ctx* ctx, struct cj_span* span) {
+    if (span->info & cj_span_info_decoded) {
+        return span->ptr;
+    }
+    return ctx != NULL ? cj_parse_ctx_dup(ctx, span) : cj_span_dup(span);
+}
+
 enum cj_error_code cj_open_entry(enum cj_container_type type, void* parent, unsigned int parent_tag, union cj_key* key,
                                  void** open, unsigned int* tag) {
     (void)parent_tag;
     (void)tag;
 
-    struct cj_entity* parent_entry = (struct cj_entity*)parent;
-    struct cj_entity* entry = calloc(1, sizeof(struct cj_entity));
+    struct cj_entity_container* parent_container = parent;
+    struct cj_entity* parent_entry = &parent_container->entity;
+    struct cj_entity_container* container = cj_entity_alloc(parent_container->ctx, sizeof(struct cj_entity_container));
+    if (container == NULL) {
+        return cj_error_out_of_memory;
+    }
+    container->ctx = parent_container->ctx;
+    struct cj_entity* entry = &container->entity;
 
     entry->type = type == cj_container_object ? cj_type_object : cj_type_array;
     entry->parent_type = parent_entry->type == cj_type_object ? cj_entity_parent_object : cj_entity_parent_array;
 
+    // linked right away so a tree which fails to parse can be freed as a whole, the container is still the newest
+    // child of its parent when it is closed
+    entry->next = parent_entry->first;
+    parent_entry->first = entry;
+
     if (parent_entry->type == cj_type_object) {
-        entry->id = cj_span_dup(&key->id);
+        entry->id = cj_entity_string(container->ctx, &key->id);
+        if (entry->id == NULL) {
+            return cj_error_out_of_memory;
+        }
     } else {
         entry->index = key->index;
     }
@@ -1399,32 +4552,55 @@ enum cj_entry_add_op {
     cj_entry_add_op_push,
 };
 
-enum cj_error_code cj_add_entry(enum cj_entry_add_op op, void* this_ptr, size_t index, char* id,
+void cj_entity_reverse_children(struct cj_entity* e) {
+    struct cj_entity* reversed = NULL;
+    struct cj_entity* iter = e->first;
+    while (iter != NULL) {
+        struct cj_entity* next = iter->next;
+        iter->next = reversed;
+        reversed = iter;
+        iter = next;
+    }
+    e->first = reversed;
+}
+
+enum cj_error_code cj_add_entry(enum cj_entry_add_op op, void* this_ptr, size_t index, struct cj_span* id,
                                 struct cj_value* value) {
-    struct cj_entity* this = (struct cj_entity*)this_ptr;
-    struct cj_entity* entity;
-
-    if (value->type == cj_type_object) {
-        // value->array is an opened object. ->type and ->parent_type are already set in cj_open_entry
-        entity = value->object;
-    } else if (value->type == cj_type_array) {
-        // value->array is an opened array. ->type and ->parent_type are already set in cj_open_entry
-        entity = value->array;
-    } else {
-        entity = calloc(1, sizeof(struct cj_entity));
-        entity->parent_type = op == cj_entry_add_op_set ? cj_entity_parent_object : cj_entity_parent_array;
-        entity->type = value->type;
+    struct cj_entity_container* container = this_ptr;
+    struct cj_entity* this = &container->entity;
+
+    if (value->type == cj_type_object || value->type == cj_type_array) {
+        // value->object is the opened container, cj_open_entry already set it up and linked it to this. Its children
+        // are prepended while it is parsed and put in order once it is complete, appending would walk the whole list
+        // for every child
+        cj_entity_reverse_children(value->object);
+        return cj_error_none;
+    }
+
+    struct cj_entity* entity = cj_entity_alloc(container->ctx, sizeof(struct cj_entity));
+    if (entity == NULL) {
+        return cj_error_out_of_memory;
     }
+    entity->parent_type = op == cj_entry_add_op_set ? cj_entity_parent_object : cj_entity_parent_array;
+    entity->type = value->type;
+    entity->next = this->first;
+    this->first = entity;
 
     if (op == cj_entry_add_op_set) {
-        entity->id = id;
+        entity->id = cj_entity_string(container->ctx, id);
+        if (entity->id == NULL) {
+            return cj_error_out_of_memory;
+        }
     } else {
         entity->index = index;
     }
 
     switch (value->type) {
         case cj_type_string:
-            entity->string = cj_span_dup(&value->string);
+            entity->string = cj_entity_string(container->ctx, &value->string);
+            if (entity->string == NULL) {
+                return cj_error_out_of_memory;
+            }
             break;
         case cj_type_number:
             entity->number = value->number;
@@ -1437,17 +4613,6 @@ enum cj_error_code cj_add_entry(enum cj_entry_add_op op, void* this_ptr, size_t
         case cj_type_null:
             break;
     }
-
-    if (this->first == NULL) {
-        this->first = entity;
-    } else {
-        struct cj_entity* iter = this->first;
-        while (iter->next != NULL) {
-            iter = iter->next;
-        }
-        iter->next = entity;
-    }
-
     return cj_error_none;
 }
 
@@ -1458,10 +4623,21 @@ enum cj_error_code cj_push_entry(void* this_ptr, unsigned int tag, size_t index,
 
 enum cj_error_code cj_set_entry(void* this_ptr, unsigned int tag, struct cj_span* id, struct cj_value* value) {
     (void)tag;
-    return cj_add_entry(cj_entry_add_op_set, this_ptr, 0, cj_span_dup(id), value);
+    return cj_add_entry(cj_entry_add_op_set, this_ptr, 0, id, value);
 }
 
 struct cj_entity* cj_decode(char* b, struct cj_error* error_receiver) {
+    return cj_decode_n(b, strlen(b), error_receiver);
+}
+
+struct cj_entity* cj_decode_n(const char* json, size_t length, struct cj_error* error_receiver) {
+    return cj_decode_flags(json, length, 0, error_receiver);
+}
+
+struct cj_entity* cj_decode_buffer(struct cj_parse_ctx* ctx, char* json, size_t length, unsigned int flags,
+                                   struct cj_error* error_receiver) {
+    char* b = json;
+    char* end = b + length;
     struct cj_error error = {0};
     if (error_receiver != NULL) {
         error_receiver->type = cj_error_none;
@@ -1471,9 +4647,21 @@ struct cj_entity* cj_decode(char* b, struct cj_error* error_receiver) {
         error_receiver->stopped_at = NULL;
     }
 
-    struct cj_parser parser = {cj_open_entry, cj_push_entry, cj_set_entry};
+    struct cj_parser parser = {.open = cj_open_entry,
+                               .push = cj_push_entry,
+                               .set = cj_set_entry,
+                               .flags = flags & cj_parse_insitu,
+                               .ctx = ctx};
 
-    struct cj_entity* root = calloc(1, sizeof(struct cj_entity));
+    struct cj_entity_container* root_container = cj_entity_alloc(ctx, sizeof(struct cj_entity_container));
+    if (root_container == NULL) {
+        if (error_receiver != NULL) {
+            *error_receiver = cj_error_new(cj_error_out_of_memory, json, json);
+        }
+        return NULL;
+    }
+    root_container->ctx = ctx;
+    struct cj_entity* root = &root_container->entity;
     root->type = cj_type_null;  // just any default
     root->parent_type = cj_entity_parent_root;
     root->id = NULL;
@@ -1481,9 +4669,12 @@ struct cj_entity* cj_decode(char* b, struct cj_error* error_receiver) {
     root->next = NULL;
     root->first = NULL;
 
-    enum cj_error_code err = cj_peek_type(&b, &root->type);
+    enum cj_error_code err = cj_parse_check_utf8(flags, &b, end);
+    if (err == cj_error_none) {
+        err = cj_peek_type(&b, end, &root->type);
+    }
     if (err != cj_error_none) {
-        error = cj_error_new(err, b, 0);
+        error = cj_error_new(err, (char*)json, b);
         if (error_receiver != NULL) {
             error_receiver->type = error.type;
             error_receiver->data = error.data;
@@ -1491,7 +4682,9 @@ struct cj_entity* cj_decode(char* b, struct cj_error* error_receiver) {
             error_receiver->column = error.column;
             error_receiver->stopped_at = error.stopped_at;
         }
-        free(root);
+        if (ctx == NULL) {
+            cj_entity_free_tree(root, !(flags & cj_parse_insitu));
+        }
         return NULL;
     }
 
@@ -1503,30 +4696,38 @@ struct cj_entity* cj_decode(char* b, struct cj_error* error_receiver) {
 
     switch (root->type) {
         case cj_type_string:
-            err = cj_parse_string(B, &value);
-            root->string = cj_span_dup(&value.string);
+            err = cj_parse_string(B, end, &value);
+            if (err == cj_error_none) {
+                if (flags & cj_parse_insitu) {
+                    cj_span_unescape_insitu(&value.string);
+                }
+                root->string = cj_entity_string(ctx, &value.string);
+                err = root->string == NULL ? cj_error_out_of_memory : cj_error_none;
+            }
             break;
         case cj_type_object:
-            error = cj_parse_object_into(&parser, b, root, 0);
+            error = cj_parse_into_n(&parser, b, length, root, 0, cj_container_object);
+            cj_entity_reverse_children(root);
             break;
         case cj_type_array:
-            error = cj_parse_array_into(&parser, b, root, 0);
+            error = cj_parse_into_n(&parser, b, length, root, 0, cj_container_array);
+            cj_entity_reverse_children(root);
             break;
         case cj_type_number:
-            err = cj_parse_number(B, &value);
+            err = cj_parse_number(B, end, &value);
             root->number = value.number;
             break;
         case cj_type_bool:
-            err = cj_parse_bool(B, &value);
+            err = cj_parse_bool(B, end, &value);
             root->boolean = value.boolean;
             break;
         case cj_type_null:
-            err = cj_parse_null(B, &value);
+            err = cj_parse_null(B, end, &value);
             break;
     }
 
-    // NOTICE we could here check if b + strlen(b) == *B to see if there was extra data in the string after the json but
-    // before the EOF. Currently extra data does not trigger a parse error.
+    // NOTICE we could here check if end == *B to see if there was extra data in the string after the json but before
+    // the EOF. Currently extra data does not trigger a parse error.
     // printf("'%s' == '%s'\n", *B, b);
 
     if (err != cj_error_none) {
@@ -1541,12 +4742,29 @@ struct cj_entity* cj_decode(char* b, struct cj_error* error_receiver) {
             error_receiver->column = error.column;
             error_receiver->stopped_at = error.stopped_at;
         }
-        free(root);
+        if (ctx == NULL) {
+            cj_entity_free_tree(root, !(flags & cj_parse_insitu));
+        }
         return NULL;
     }
     return root;
 }
 
+struct cj_entity* cj_decode_flags(const char* json, size_t length, unsigned int flags,
+                                  struct cj_error* error_receiver) {
+    // only cj_decode_insitu may write to the input
+    return cj_decode_buffer(NULL, (char*)json, length, flags & ~cj_parse_insitu, error_receiver);
+}
+
+struct cj_entity* cj_decode_insitu(char* json, size_t length, unsigned int flags, struct cj_error* error_receiver) {
+    return cj_decode_buffer(NULL, json, length, flags | cj_parse_insitu, error_receiver);
+}
+
+struct cj_entity* cj_decode_ctx(struct cj_parse_ctx* ctx, const char* json, size_t length, unsigned int flags,
+                                struct cj_error* error_receiver) {
+    return cj_decode_buffer(ctx, (char*)json, length, flags & ~cj_parse_insitu, error_receiver);
+}
+
 // Encode
 
 const char* CJ_ENCODER_CONST_NULL = "null";
@@ -1801,17 +5019,70 @@ void cj_encoder_push_decimal(struct cj_encoder* encoder, float value) {
     cj_encoder_push_numeric(encoder, cj_numeric_decimal(value));
 }
 
+void cj_encoder_push_integer64(struct cj_encoder* encoder, int64_t value) {
+    cj_encoder_push_numeric(encoder, cj_numeric_integer64(value));
+}
+
+void cj_encoder_push_uinteger64(struct cj_encoder* encoder, uint64_t value) {
+    cj_encoder_push_numeric(encoder, cj_numeric_uinteger64(value));
+}
+
+void cj_encoder_push_decimal64(struct cj_encoder* encoder, double value) {
+    cj_encoder_push_numeric(encoder, cj_numeric_decimal64(value));
+}
+
 void cj_encoder_push_numeric(struct cj_encoder* encoder, struct cj_numeric value) {
-    char* buffer;
-    if (value.type == cj_numeric_type_integer) {
-        size_t len = snprintf(NULL, 0, "%d", value.integer);
-        buffer = calloc(1, sizeof(char) * (len + 1));
-        snprintf(buffer, len + 1, "%d", value.integer);
-    } else {
-        size_t len = snprintf(NULL, 0, "%g", value.decimal);
-        buffer = calloc(1, sizeof(char) * (len + 1));
-        snprintf(buffer, len + 1, "%g", value.decimal);
+    // large enough for any int64_t, uint64_t and any double written with %.17g
+    char number[32] = "";
+    if ((value.type == cj_numeric_type_decimal && !isfinite(value.decimal)) ||
+        (value.type == cj_numeric_type_decimal64 && !isfinite(value.decimal64))) {
+        // json has no nan or infinity
+        cj_encoder_push_null(encoder);
+        return;
+    }
+    switch (value.type) {
+        case cj_numeric_type_integer:
+            snprintf(number, sizeof(number), "%d", value.integer);
+            break;
+        case cj_numeric_type_decimal:
+            snprintf(number, sizeof(number), "%g", value.decimal);
+            break;
+        case cj_numeric_type_integer64:
+            snprintf(number, sizeof(number), "%" PRId64, value.integer64);
+            break;
+        case cj_numeric_type_uinteger64:
+            snprintf(number, sizeof(number), "%" PRIu64, value.uinteger64);
+            break;
+        case cj_numeric_type_decimal64:
+            // use the shortest precision which parses back to the same double
+            for (int precision = 15; precision <= 17; precision++) {
+                snprintf(number, sizeof(number), "%.*g", precision, value.decimal64);
+                char* b = number;
+                double parsed;
+                if (cj_parse_decimal(&b, number + strlen(number), &parsed) == cj_error_none &&
+                    parsed == value.decimal64) {
+                    break;
+                }
+            }
+            break;
+        case cj_numeric_type_integer_span:
+        case cj_numeric_type_decimal_span: {
+            // pass the text through unchanged
+            char* buffer = calloc(1, sizeof(char) * (value.text.length + 1));
+            memcpy(buffer, value.text.ptr, value.text.length);
+            cj_encoder_push_value(encoder, buffer);
+            return;
+        }
+    }
+    size_t len = strlen(number);
+    if ((value.type == cj_numeric_type_decimal || value.type == cj_numeric_type_decimal64) &&
+        strpbrk(number, ".e") == NULL) {
+        // keep whole decimals like 1.0 from being decoded as integers
+        memcpy(number + len, ".0", 3);
+        len += 2;
     }
+    char* buffer = calloc(1, sizeof(char) * (len + 1));
+    memcpy(buffer, number, len);
     cj_encoder_push_value(encoder, buffer);
 }
 
@@ -40,6 +40,11 @@ struct project {
     struct metadata* metadata;
 };
 
+// The keys of a project, a cj_key_matcher maps a key to its index with a single hash lookup
+enum project_key { KEY_NAME, KEY_DESCRIPTION, KEY_PROGRESS, KEY_TAGS, KEY_METADATA, KEY_DONE };
+const char* project_keys[] = {"name", "description", "progress", "tags", "metadata", "done"};
+struct cj_key_matcher project_matcher;
+
 // Setting up the parser callbacks (the parser will call back to you once data is parsed for you to store it some
 // where).
 enum cj_error_code open(enum cj_container_type type, void* parent, unsigned int parent_tag, union cj_key* key,
@@ -48,13 +53,15 @@ enum cj_error_code open(enum cj_container_type type, void* parent, unsigned int
     switch (parent_tag) {
         case TAG_PROJECT:
             struct project* p = (struct project*)parent;
-            if (cj_span_eq(&key->id, "progress")) {
-                *open = &p->progress;
-                *tag = TAG_PROGRESS;
-            }
-            if (cj_span_eq(&key->id, "tags")) {
-                *open = &p->tags;
-                *tag = TAG_TAGS;
+            switch (cj_key_matcher_find(&project_matcher, &key->id)) {
+                case KEY_PROGRESS:
+                    *open = &p->progress;
+                    *tag = TAG_PROGRESS;
+                    break;
+                case KEY_TAGS:
+                    *open = &p->tags;
+                    *tag = TAG_TAGS;
+                    break;
             }
             break;
     }
@@ -77,17 +84,27 @@ enum cj_error_code set(void* this, unsigned int tag, struct cj_span* id, struct
     switch (tag) {
         case TAG_PROJECT:
             struct project* p = (struct project*)this;
-            if (cj_span_eq(id, "name") && value->type == cj_type_string) {
-                p->name = cj_span_dup(&value->string);
-            }
-            if (cj_span_eq(id, "description") && value->type == cj_type_string) {
-                p->description = cj_span_dup(&value->string);
-            }
-            if (cj_span_eq(id, "done") && value->type == cj_type_bool) {
-                p->done = value->boolean;
-            }
-            if (cj_span_eq(id, "metadata") && value->type == cj_type_null) {
-                p->metadata = NULL;
+            switch (cj_key_matcher_find(&project_matcher, id)) {
+                case KEY_NAME:
+                    if (value->type == cj_type_string) {
+                        p->name = cj_span_dup(&value->string);
+                    }
+                    break;
+                case KEY_DESCRIPTION:
+                    if (value->type == cj_type_string) {
+                        p->description = cj_span_dup(&value->string);
+                    }
+                    break;
+                case KEY_DONE:
+                    if (value->type == cj_type_bool) {
+                        p->done = value->boolean;
+                    }
+                    break;
+                case KEY_METADATA:
+                    if (value->type == cj_type_null) {
+                        p->metadata = NULL;
+                    }
+                    break;
             }
             break;
         case TAG_PROGRESS:
@@ -104,8 +121,14 @@ int main(int argc, char* argv[]) {
     (void)argc;
     (void)argv;
 
+    // Build the key matcher once, it can be used for any number of documents
+    if (cj_key_matcher_init(&project_matcher, project_keys, sizeof(project_keys) / sizeof(project_keys[0])) !=
+        cj_error_none) {
+        return EXIT_FAILURE;
+    }
+
     // Start Parsing
-    struct cj_parser parser = {open, push, set};
+    struct cj_parser parser = {.open = open, .push = push, .set = set};
     struct project project = {0};
     struct cj_error err = cj_parse_object_into(&parser, input_data, &project, TAG_PROJECT);
 
@@ -115,6 +138,7 @@ int main(int argc, char* argv[]) {
     // remember to free memory allocated via cj_span_dup
     free(project.name);
     free(project.description);
+    cj_key_matcher_free(&project_matcher);
     return EXIT_SUCCESS;
 }
 
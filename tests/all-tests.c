@@ -6,16 +6,33 @@
 #include "../cj.h" // IWYU pragma: keep for cj impl
 
 // include tests
+#include "tests/cj_char_class.h"
 #include "tests/cj_de-en-code.h"
 #include "tests/cj_decode.h"
 #include "tests/cj_encode.h"
+#include "tests/cj_key_matcher.h"
+#include "tests/cj_parse_bound.h"
+#include "tests/cj_parse_bounded.h"
+#include "tests/cj_parse_ctx.h"
+#include "tests/cj_parse_depth.h"
 #include "tests/cj_parse_errors.h"
 #include "tests/cj_parse_number.h"
+#include "tests/cj_parse_number_array.h"
+#include "tests/cj_parse_push_batch.h"
+#include "tests/cj_parse_skip.h"
+#include "tests/cj_parse_string.h"
 #include "tests/cj_parse_to_array.h"
 #include "tests/cj_parse_to_struct.h"
+#include "tests/cj_parse_utf8.h"
+#include "tests/cj_parse_whitespace.h"
 #include "tests/cj_str.h"
+#include "tests/cj_validate.h"
 
-TEST_LIST = {CJ_TESTS_PARSE_TO_ARRAY, CJ_TESTS_PARSE_TO_STRUCT, CJ_TESTS_STR,
-             CJ_TESTS_PARSE_NUMBER,   CJ_TESTS_PARSE_ERRORS,    CJ_TESTS_DECODE,
-             CJ_TESTS_ENCODE,         CJ_TESTS_DE_EN_CODE,      {NULL, NULL}};
-
+TEST_LIST = {CJ_TESTS_PARSE_TO_ARRAY,     CJ_TESTS_PARSE_TO_STRUCT,    CJ_TESTS_STR,
+             CJ_TESTS_PARSE_NUMBER,       CJ_TESTS_PARSE_ERRORS,       CJ_TESTS_DECODE,
+             CJ_TESTS_ENCODE,             CJ_TESTS_DE_EN_CODE,         CJ_TESTS_PARSE_WHITESPACE,
+             CJ_TESTS_PARSE_STRING,       CJ_TESTS_PARSE_BOUNDED,      CJ_TESTS_CHAR_CLASS,
+             CJ_TESTS_PARSE_DEPTH,        CJ_TESTS_PARSE_SKIP,         CJ_TESTS_VALIDATE,
+             CJ_TESTS_PARSE_UTF8,         CJ_TESTS_KEY_MATCHER,        CJ_TESTS_PARSE_BOUND,
+             CJ_TESTS_PARSE_PUSH_BATCH,   CJ_TESTS_PARSE_NUMBER_ARRAY, CJ_TESTS_PARSE_CTX,
+             {NULL, NULL}};
@@ -0,0 +1,53 @@
+#include <stdbool.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_CHAR_CLASS {"cj_char_class", test_cj_char_class}
+
+void test_cj_char_class() {
+    for (int i = 0; i < 256; i++) {
+        char c = (char)i;
+
+        bool ws = c == ' ' || c == '\n' || c == '\r' || c == '\t';
+        TEST_CHECK_(!!CJ_IS_WS(c) == ws, "white space 0x%02x", i);
+
+        bool digit = c >= '0' && c <= '9';
+        TEST_CHECK_(!!CJ_IS_DIGIT(c) == digit, "digit 0x%02x", i);
+
+        unsigned char v = 0xFF;
+        bool hex = digit || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+        TEST_CHECK_(cju_hex_to_uchar(c, &v) == hex, "hex 0x%02x", i);
+        if (hex) {
+            unsigned char expected = digit ? c - '0' : (c | 0x20) - 'a' + 10;
+            TEST_CHECK_(v == expected, "hex value 0x%02x", i);
+        }
+
+        bool escape = c != '\0' && strchr("\"\\/bfnrt", c) != NULL;
+        TEST_CHECK_(!!(CJ_CC(c) & CJ_CC_ESCAPE) == escape, "escape 0x%02x", i);
+    }
+
+    struct {
+        char c;
+        enum cj_type type;
+    } starts[] = {{'{', cj_type_object}, {'[', cj_type_array}, {'"', cj_type_string}, {'t', cj_type_bool},
+                  {'f', cj_type_bool},   {'n', cj_type_null},  {'-', cj_type_number}, {'0', cj_type_number},
+                  {'9', cj_type_number}};
+    for (size_t i = 0; i < sizeof(starts) / sizeof(starts[0]); i++) {
+        char* b = &starts[i].c;
+        enum cj_type type = cj_type_null;
+        TEST_CHECK(cj_peek_type(&b, b + 1, &type) == cj_error_none);
+        TEST_CHECK(type == starts[i].type);
+    }
+
+    char* rejected = "}]:,+.eE \nab";
+    for (char* b = rejected; *b != '\0'; b++) {
+        enum cj_type type = cj_type_null;
+        char* cursor = b;
+        TEST_CHECK_(cj_peek_type(&cursor, b + 1, &type) == cj_error_exp_value, "peek '%c'", *b);
+    }
+    enum cj_type type = cj_type_null;
+    char* empty = rejected;
+    TEST_CHECK(cj_peek_type(&empty, empty, &type) == cj_error_exp_value);
+}
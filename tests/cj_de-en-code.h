@@ -10,6 +10,7 @@ void test_cj_de_en_code() {
     struct cj_entity* obj = cj_decode(json, NULL);
     char* enced = cj_encode(obj);
     TEST_ASSERT(strcmp(json, enced) == 0);
+    free(enced);
     cj_entity_free(obj);
 }
 
@@ -5,7 +5,7 @@
     {"cj_decode_object", test_cj_decode_object}, {"cj_decode_array", test_cj_decode_array}, \
         {"cj_decode", test_cj_decode}, {                                                    \
         "cj_cj_decode_extra_before_eof", test_cj_decode_extra_before_eof                    \
-    }
+    }, {"cj_decode_insitu", test_cj_decode_insitu}
 
 void test_cj_decode_object() {
     char* json =
@@ -77,7 +77,7 @@ void test_cj_decode_array() {
 
     TEST_ASSERT(cj_entity_get_item(list, 2) != NULL);
     TEST_ASSERT(cj_entity_get_item(list, 2)->type == cj_type_number);
-    TEST_ASSERT(cj_entity_as_number(cj_entity_get_item(list, 2)).decimal == 7.2f);
+    TEST_ASSERT(cj_entity_as_number(cj_entity_get_item(list, 2)).decimal64 == 7.2);
 
     TEST_ASSERT(cj_entity_get_item(list, 3) != NULL);
     TEST_ASSERT(cj_entity_get_item(list, 3)->type == cj_type_string);
@@ -87,7 +87,7 @@ void test_cj_decode_array() {
     TEST_ASSERT(cj_entity_get_item(list, 4)->type == cj_type_bool);
     TEST_ASSERT(cj_entity_as_bool(cj_entity_get_item(list, 4)) == false);
 
-    cj_entity_free(obj);
+    cj_entity_free(list);
 }
 
 void test_cj_decode() {
@@ -113,7 +113,7 @@ void test_cj_decode() {
     thing = cj_decode(json_number, NULL);
     TEST_ASSERT(thing != NULL);
     TEST_ASSERT(thing->type == cj_type_number);
-    TEST_ASSERT(cj_entity_as_number(thing).decimal == 77.6f);
+    TEST_ASSERT(cj_entity_as_number(thing).decimal64 == 77.6);
     cj_entity_free(thing);
 
     thing = cj_decode(json_null, NULL);
@@ -121,6 +121,11 @@ void test_cj_decode() {
     TEST_ASSERT(thing->type == cj_type_null);
     TEST_ASSERT(cj_entity_is_null(thing));
     cj_entity_free(thing);
+
+    // unpaired surrogates are rejected before anything is decoded
+    struct cj_error err;
+    TEST_CHECK(cj_decode_n("[\"\\ud800\"]", 10, &err) == NULL);
+    TEST_CHECK(err.type == cj_error_unpaired_surrogate);
 }
 
 void test_cj_decode_extra_before_eof() {
@@ -148,7 +153,7 @@ void test_cj_decode_extra_before_eof() {
     thing = cj_decode(json_number, NULL);
     TEST_ASSERT(thing != NULL);
     TEST_ASSERT(thing->type == cj_type_number);
-    TEST_ASSERT(cj_entity_as_number(thing).decimal == 77.6f);
+    TEST_ASSERT(cj_entity_as_number(thing).decimal64 == 77.6);
     cj_entity_free(thing);
 
     thing = cj_decode(json_null, NULL);
@@ -168,3 +173,29 @@ void test_cj_decode_extra_before_eof() {
     cj_entity_free(thing);
 }
 
+
+void test_cj_decode_insitu() {
+    char json[] = "{\"na\\u006de\": \"My \\\"Project\\\"\", \"tags\": [\"writing\", \"\\u00e4\\n\"], \"done\": true}";
+
+    struct cj_entity* obj = cj_decode_insitu(json, strlen(json), 0, NULL);
+    TEST_ASSERT(obj != NULL);
+    struct cj_entity* name = cj_entity_get_member(obj, "name");
+    TEST_ASSERT(name != NULL);
+    TEST_CHECK(strcmp(cj_entity_as_string(name), "My \"Project\"") == 0);
+    // strings and ids point into the input
+    TEST_CHECK(cj_entity_as_string(name) > json && cj_entity_as_string(name) < json + sizeof(json));
+    TEST_CHECK(name->id > json && name->id < json + sizeof(json));
+    struct cj_entity* tags = cj_entity_get_member(obj, "tags");
+    TEST_ASSERT(tags != NULL);
+    TEST_CHECK(strcmp(cj_entity_as_string(cj_entity_get_item(tags, 0)), "writing") == 0);
+    TEST_CHECK(strcmp(cj_entity_as_string(cj_entity_get_item(tags, 1)), "\u00e4\n") == 0);
+    TEST_CHECK(cj_entity_as_bool(cj_entity_get_member(obj, "done")));
+    cj_entity_free_insitu(obj);
+
+    char string[] = "\"tab\\tbed\"";
+    struct cj_entity* thing = cj_decode_insitu(string, strlen(string), 0, NULL);
+    TEST_ASSERT(thing != NULL);
+    TEST_CHECK(strcmp(cj_entity_as_string(thing), "tab\tbed") == 0);
+    TEST_CHECK(cj_entity_as_string(thing) == string + 1);
+    cj_entity_free_insitu(thing);
+}
@@ -1,10 +1,11 @@
+#include <math.h>
+
 #include "../cj.h"
 #include "acutest.h"
 
-#define CJ_TESTS_ENCODE                                                         \
-    {"cj_encode", test_cj_encode}, {"cj_encode_ascii", test_cj_encode_ascii}, { \
-        "cj_encode_empty", test_cj_encode_empty                                 \
-    }
+#define CJ_TESTS_ENCODE                                                                     \
+    {"cj_encode", test_cj_encode}, {"cj_encode_ascii", test_cj_encode_ascii},               \
+        {"cj_encode_empty", test_cj_encode_empty}, {"cj_encode_numeric64", test_cj_encode_numeric64}
 
 void test_cj_encode() {
     struct cj_encoder enc;
@@ -25,6 +26,7 @@ void test_cj_encode() {
     // the encoder encodes floats to %.6g
     TEST_ASSERT(
         strcmp(result, "{\"name\":\"this is my name\",\"description\":\"Me? Im just a fish!\",\"pi\":3.14153}") == 0);
+    free(result);
 }
 
 bool test_cj_encode_ascii_case(char* a, char* b) {
@@ -117,3 +119,55 @@ void test_cj_encode_empty() {
     free(encoded);
 }
 
+void test_cj_encode_numeric64() {
+    struct cj_encoder enc;
+    cj_encoder_init(&enc);
+    cj_encoder_begin_array(&enc);
+    cj_encoder_push_integer64(&enc, INT64_MIN);
+    cj_encoder_push_uinteger64(&enc, UINT64_MAX);
+    cj_encoder_push_decimal64(&enc, 0.1);
+    cj_encoder_push_decimal64(&enc, 1234567.891);
+    cj_encoder_push_decimal64(&enc, 0.1 + 0.2);
+    cj_encoder_push_decimal64(&enc, 1e300);
+    cj_encoder_end(&enc);
+    char* encoded = cj_encoder_collapse(&enc);
+    TEST_ASSERT(strcmp("[-9223372036854775808,18446744073709551615,0.1,1234567.891,0.30000000000000004,1e+300]",
+                       encoded) == 0);
+
+    // decode and encode again without losing digits
+    struct cj_entity* decoded = cj_decode(encoded, NULL);
+    char* reencoded = cj_encode(decoded);
+    TEST_ASSERT(strcmp(encoded, reencoded) == 0);
+    free(reencoded);
+    cj_entity_free(decoded);
+    free(encoded);
+
+    // whole numbers stay decimals and non finite values, which json has no syntax for, become null
+    cj_encoder_init(&enc);
+    cj_encoder_begin_array(&enc);
+    cj_encoder_push_decimal64(&enc, 1.0);
+    cj_encoder_push_decimal64(&enc, -0.0);
+    cj_encoder_push_decimal64(&enc, 1e300);
+    cj_encoder_push_decimal64(&enc, NAN);
+    cj_encoder_push_decimal64(&enc, -INFINITY);
+    cj_encoder_push_decimal(&enc, 2.0f);
+    cj_encoder_end(&enc);
+    encoded = cj_encoder_collapse(&enc);
+    TEST_CHECK(strcmp("[1.0,-0.0,1e+300,null,null,2.0]", encoded) == 0);
+    TEST_MSG("got: %s", encoded);
+
+    decoded = cj_decode(encoded, NULL);
+    TEST_ASSERT(decoded != NULL);
+    struct cj_entity* item = decoded->first;
+    double expected[] = {1.0, -0.0, 1e300};
+    for (size_t i = 0; i < 3; i++, item = item->next) {
+        TEST_CHECK(item->type == cj_type_number && item->number.type == cj_numeric_type_decimal64);
+        TEST_CHECK(item->number.decimal64 == expected[i] && signbit(item->number.decimal64) == signbit(expected[i]));
+    }
+    TEST_CHECK(item->type == cj_type_null && item->next->type == cj_type_null);
+    reencoded = cj_encode(decoded);
+    TEST_CHECK(strcmp(encoded, reencoded) == 0);
+    free(reencoded);
+    cj_entity_free(decoded);
+    free(encoded);
+}
@@ -0,0 +1,190 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_KEY_MATCHER                                                                                      \
+    {"cj_key_matcher", test_cj_key_matcher}, {"cj_key_matcher_wide_object", test_cj_key_matcher_wide_object}, \
+        {"cj_parse_key_hash", test_cj_parse_key_hash}, {"cj_key_matcher_perfect", test_cj_key_matcher_perfect}
+
+int tkm_find(struct cj_key_matcher* m, char* json) {
+    char* b = json;
+    struct cj_value value = {0};
+    if (cj_parse_string(&b, json + strlen(json), &value) != cj_error_none) {
+        return -2;
+    }
+    return cj_key_matcher_find(m, &value.string);
+}
+
+void test_cj_key_matcher() {
+    const char* keys[] = {"name", "description", "", "done", "a key longer than eight bytes", "\xc3\xa4", "name"};
+    struct cj_key_matcher m;
+    TEST_ASSERT(cj_key_matcher_init(&m, keys, sizeof(keys) / sizeof(keys[0])) == cj_error_none);
+    TEST_CHECK(m.displace != NULL);
+
+    TEST_CHECK(tkm_find(&m, "\"name\"") == 0);
+    TEST_CHECK(tkm_find(&m, "\"description\"") == 1);
+    TEST_CHECK(tkm_find(&m, "\"\"") == 2);
+    TEST_CHECK(tkm_find(&m, "\"done\"") == 3);
+    TEST_CHECK(tkm_find(&m, "\"a key longer than eight bytes\"") == 4);
+    TEST_CHECK(tkm_find(&m, "\"\xc3\xa4\"") == 5);
+
+    // misses
+    TEST_CHECK(tkm_find(&m, "\"nam\"") == -1);
+    TEST_CHECK(tkm_find(&m, "\"names\"") == -1);
+    TEST_CHECK(tkm_find(&m, "\"Name\"") == -1);
+    TEST_CHECK(tkm_find(&m, "\"a key longer than eight bytez\"") == -1);
+    TEST_CHECK(tkm_find(&m, "\"a key longer than any key in the matcher\"") == -1);
+
+    // escaped, hand built and in place decoded spans
+    TEST_CHECK(tkm_find(&m, "\"na\\u006de\"") == 0);
+    TEST_CHECK(tkm_find(&m, "\"\\u00e4\"") == 5);
+    TEST_CHECK(tkm_find(&m, "\"do\\ne\"") == -1);
+    struct cj_span span = {.ptr = "\"done\"", .length = 6};
+    TEST_CHECK(cj_key_matcher_find(&m, &span) == 3);
+    char insitu[] = "\"descr\\u0069ption\"";
+    span = (struct cj_span){.ptr = insitu, .length = strlen(insitu)};
+    cj_span_unescape_insitu(&span);
+    TEST_CHECK(cj_key_matcher_find(&m, &span) == 1);
+
+    cj_key_matcher_free(&m);
+
+    struct cj_key_matcher empty;
+    TEST_ASSERT(cj_key_matcher_init(&empty, NULL, 0) == cj_error_none);
+    TEST_CHECK(tkm_find(&empty, "\"\"") == -1);
+    TEST_CHECK(tkm_find(&empty, "\"name\"") == -1);
+    cj_key_matcher_free(&empty);
+}
+
+struct tkm_wide {
+    struct cj_key_matcher* matcher;
+    int values[64];
+    size_t misses;
+};
+
+enum cj_error_code tkm_wide_set(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
+    (void)tag;
+    struct tkm_wide* wide = this;
+    int field = cj_key_matcher_find(wide->matcher, id);
+    if (field == -1) {
+        wide->misses++;
+    } else {
+        wide->values[field] = value->number.integer;
+    }
+    return cj_error_none;
+}
+
+void test_cj_key_matcher_wide_object() {
+    char names[64][16];
+    const char* keys[64];
+    char json[64 * 32] = "{";
+    char* out = json + 1;
+    for (int i = 0; i < 64; i++) {
+        sprintf(names[i], "field_%d", i);
+        keys[i] = names[i];
+        // every fourth field is missing from the document, every document member is followed by an unknown one
+        if (i % 4 != 3) {
+            out += sprintf(out, "%s\"field_%d\": %d, \"other_%d\": 0", i == 0 ? "" : ", ", i, i * 10, i);
+        }
+    }
+    sprintf(out, "}");
+
+    struct cj_key_matcher m;
+    TEST_ASSERT(cj_key_matcher_init(&m, keys, 64) == cj_error_none);
+    struct tkm_wide wide = {.matcher = &m};
+    for (int i = 0; i < 64; i++) {
+        wide.values[i] = -1;
+    }
+    struct cj_parser parser = {.open = cj_open_void, .push = cj_push_void, .set = tkm_wide_set};
+    TEST_ASSERT(cj_parse_object_into(&parser, json, &wide, 0).type == cj_error_none);
+
+    TEST_CHECK(wide.misses == 48);
+    for (int i = 0; i < 64; i++) {
+        TEST_CHECK_(wide.values[i] == (i % 4 == 3 ? -1 : i * 10), "field_%d", i);
+    }
+    cj_key_matcher_free(&m);
+}
+
+// Every key the callbacks see is logged as "<key>:<h|->", h if the key carries the correct hash. Keys of containers are
+// seen by open and set.
+char tkm_hash_log[256];
+
+void tkm_hash_log_key(struct cj_span* id) {
+    char key[32];
+    cj_span_cpy(id, key, sizeof(key));
+    bool hashed = (id->info & cj_span_info_hashed) && id->hash == cj_hash(key, strlen(key));
+    sprintf(tkm_hash_log + strlen(tkm_hash_log), "%s:%c ", key, hashed ? 'h' : '-');
+}
+
+enum cj_error_code tkm_hash_open(enum cj_container_type type, void* parent, unsigned int parent_tag,
+                                 union cj_key* key, void** open, unsigned int* tag) {
+    (void)type;
+    (void)parent;
+    *open = NULL;
+    *tag = 1;
+    if (parent_tag == 1) {
+        tkm_hash_log_key(&key->id);
+    }
+    return cj_error_none;
+}
+
+enum cj_error_code tkm_hash_set(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    (void)value;
+    tkm_hash_log_key(id);
+    return cj_error_none;
+}
+
+void test_cj_parse_key_hash() {
+    struct cj_parser parser = {.open = tkm_hash_open, .push = cj_push_void, .set = tkm_hash_set};
+    const char* json = "{\"name\": 1, \"a\\tb\": 2, \"\": 3, \"long key name\": {\"x\": 4}}";
+
+    tkm_hash_log[0] = '\0';
+    TEST_ASSERT(cj_parse_object_into_n(&parser, json, strlen(json), NULL, 1).type == cj_error_none);
+    // keys with escapes are only hashed if they are decoded in place
+    TEST_CHECK(strcmp(tkm_hash_log, "name:h a\tb:- :h long key name:h x:h long key name:h ") == 0);
+
+    char* insitu = strdup(json);
+    tkm_hash_log[0] = '\0';
+    TEST_ASSERT(cj_parse_object_into_insitu(&parser, insitu, strlen(insitu), NULL, 1).type == cj_error_none);
+    TEST_CHECK(strcmp(tkm_hash_log, "name:h a\tb:h :h long key name:h x:h long key name:h ") == 0);
+    free(insitu);
+
+    // the const entry points ignore cj_parse_insitu and leave the input as it is
+    parser.flags = cj_parse_insitu;
+    tkm_hash_log[0] = '\0';
+    TEST_ASSERT(cj_parse_object_into_n(&parser, json, strlen(json), NULL, 1).type == cj_error_none);
+    TEST_CHECK(strcmp(tkm_hash_log, "name:h a\tb:- :h long key name:h x:h long key name:h ") == 0);
+}
+
+void test_cj_key_matcher_perfect() {
+    // key sets of many sizes, including keys that only differ in their last byte
+    static char names[2000][16];
+    static const char* keys[2000];
+    for (size_t i = 0; i < 2000; i++) {
+        sprintf(names[i], "key_%zu", i);
+        keys[i] = names[i];
+    }
+    for (size_t count = 1; count <= 2000; count = count * 3 + 1) {
+        struct cj_key_matcher m;
+        TEST_ASSERT(cj_key_matcher_init(&m, keys, count) == cj_error_none);
+        TEST_CHECK_(m.displace != NULL, "%zu keys have a perfect table", count);
+        // the table grows at most eight times beyond the probing table
+        TEST_CHECK(m.mask + 1 <= count * 2 * 8);
+
+        bool all = true;
+        char json[32];
+        for (size_t i = 0; i < count; i++) {
+            sprintf(json, "\"%s\"", keys[i]);
+            all = all && tkm_find(&m, json) == (int)i;
+        }
+        TEST_CHECK_(all, "all of %zu keys are found", count);
+        TEST_CHECK(tkm_find(&m, "\"key_\"") == -1);
+        TEST_CHECK(tkm_find(&m, "\"key_2000\"") == -1);
+        TEST_CHECK(tkm_find(&m, "\"\"") == -1);
+        cj_key_matcher_free(&m);
+    }
+}
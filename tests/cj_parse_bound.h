@@ -0,0 +1,243 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_BOUND                                                                         \
+    {"cj_parse_bound", test_cj_parse_bound}, {"cj_parse_bound_numbers", test_cj_parse_bound_numbers}, \
+        {"cj_parse_bound_errors", test_cj_parse_bound_errors},                                       \
+        {"cj_parse_bound_repeated_array", test_cj_parse_bound_repeated_array}
+
+struct tpb_progress {
+    int linesWritten;
+};
+
+struct tpb_author {
+    char* name;
+    char initials[4];
+};
+
+struct tpb_project {
+    char* name;
+    char* description;
+    struct tpb_progress progress;
+    char tags[4][20];
+    size_t tags_count;
+    struct tpb_author authors[2];
+    size_t authors_count;
+    char* aliases[3];
+    size_t aliases_count;
+    bool done;
+};
+
+const struct cj_field tpb_progress_fields[] = {
+    {.key = "linesWritten", .type = cj_field_int, .offset = offsetof(struct tpb_progress, linesWritten)},
+};
+
+const struct cj_field tpb_author_fields[] = {
+    {.key = "name", .type = cj_field_string, .offset = offsetof(struct tpb_author, name)},
+    {.key = "initials",
+     .type = cj_field_chars,
+     .offset = offsetof(struct tpb_author, initials),
+     .size = sizeof(((struct tpb_author*)0)->initials)},
+};
+
+struct cj_binding tpb_progress_binding;
+struct cj_binding tpb_author_binding;
+
+const struct cj_field tpb_tag = {.type = cj_field_chars, .size = 20};
+const struct cj_field tpb_author = {.type = cj_field_object, .binding = &tpb_author_binding};
+const struct cj_field tpb_alias = {.type = cj_field_string};
+
+const struct cj_field tpb_project_fields[] = {
+    {.key = "name", .type = cj_field_string, .offset = offsetof(struct tpb_project, name)},
+    {.key = "description", .type = cj_field_string, .offset = offsetof(struct tpb_project, description)},
+    {.key = "progress",
+     .type = cj_field_object,
+     .offset = offsetof(struct tpb_project, progress),
+     .binding = &tpb_progress_binding},
+    {.key = "tags",
+     .type = cj_field_array,
+     .offset = offsetof(struct tpb_project, tags),
+     .size = 20,
+     .capacity = 4,
+     .count_offset = offsetof(struct tpb_project, tags_count),
+     .element = &tpb_tag},
+    {.key = "authors",
+     .type = cj_field_array,
+     .offset = offsetof(struct tpb_project, authors),
+     .size = sizeof(struct tpb_author),
+     .capacity = 2,
+     .count_offset = offsetof(struct tpb_project, authors_count),
+     .element = &tpb_author},
+    {.key = "aliases",
+     .type = cj_field_array,
+     .offset = offsetof(struct tpb_project, aliases),
+     .size = sizeof(char*),
+     .capacity = 3,
+     .count_offset = offsetof(struct tpb_project, aliases_count),
+     .element = &tpb_alias},
+    {.key = "done", .type = cj_field_bool, .offset = offsetof(struct tpb_project, done)},
+};
+
+struct cj_binding tpb_project_binding;
+
+void tpb_init() {
+    TEST_ASSERT(cj_binding_init(&tpb_progress_binding, tpb_progress_fields, 1) == cj_error_none);
+    TEST_ASSERT(cj_binding_init(&tpb_author_binding, tpb_author_fields, 2) == cj_error_none);
+    TEST_ASSERT(cj_binding_init(&tpb_project_binding, tpb_project_fields, 7) == cj_error_none);
+}
+
+void tpb_free() {
+    cj_binding_free(&tpb_project_binding);
+    cj_binding_free(&tpb_author_binding);
+    cj_binding_free(&tpb_progress_binding);
+}
+
+void test_cj_parse_bound() {
+    tpb_init();
+    const char* json =
+        "{ \"name\": \"My \\\"Project\\\"\", \"description\": \"This is a project!\", \"progress\": { "
+        "\"linesWritten\": 628, \"unknown\": [1, {\"x\": null}] }, \"tags\": [\"writing\", \"book\"], "
+        "\"metadata\": {\"cdate\": 1}, \"authors\": [{\"name\": \"Ada\", \"initials\": \"ALovelace\"}, null], "
+        "\"desc\\u0072iption\": \"repeated\", \"done\": true, \"name\": null }";
+
+    struct tpb_project project = {0};
+    struct cj_error err = cj_parse_bound(&tpb_project_binding, json, strlen(json), &project);
+    TEST_ASSERT(err.type == cj_error_none);
+    TEST_CHECK(err.stopped_at == json + strlen(json));
+    TEST_CHECK(strcmp(project.name, "My \"Project\"") == 0);
+    TEST_CHECK(strcmp(project.description, "repeated") == 0);
+    TEST_CHECK(project.progress.linesWritten == 628);
+    TEST_CHECK(project.tags_count == 2);
+    TEST_CHECK(strcmp(project.tags[0], "writing") == 0);
+    TEST_CHECK(strcmp(project.tags[1], "book") == 0);
+    TEST_CHECK(project.authors_count == 2);
+    TEST_CHECK(strcmp(project.authors[0].name, "Ada") == 0);
+    TEST_CHECK(strcmp(project.authors[0].initials, "ALo") == 0);
+    TEST_CHECK(project.authors[1].name == NULL);
+    TEST_CHECK(project.done == true);
+
+    cj_bound_free(&tpb_project_binding, &project);
+    TEST_CHECK(project.name == NULL && project.description == NULL && project.authors[0].name == NULL);
+    tpb_free();
+}
+
+struct tpb_numbers {
+    int i;
+    int64_t i64;
+    uint64_t u64;
+    double d;
+};
+
+const struct cj_field tpb_numbers_fields[] = {
+    {.key = "i", .type = cj_field_int, .offset = offsetof(struct tpb_numbers, i)},
+    {.key = "i64", .type = cj_field_int64, .offset = offsetof(struct tpb_numbers, i64)},
+    {.key = "u64", .type = cj_field_uint64, .offset = offsetof(struct tpb_numbers, u64)},
+    {.key = "d", .type = cj_field_double, .offset = offsetof(struct tpb_numbers, d)},
+};
+
+enum cj_error_code tpb_numbers_case(struct cj_binding* binding, const char* json, struct tpb_numbers* numbers) {
+    *numbers = (struct tpb_numbers){0};
+    return cj_parse_bound(binding, json, strlen(json), numbers).type;
+}
+
+void test_cj_parse_bound_numbers() {
+    struct cj_binding binding;
+    struct tpb_numbers n;
+    TEST_ASSERT(cj_binding_init(&binding, tpb_numbers_fields, 4) == cj_error_none);
+
+    const char* all = "{\"i\": -7, \"i64\": -9000000000, \"u64\": 18446744073709551615, \"d\": 2.5}";
+    TEST_CHECK(tpb_numbers_case(&binding, all, &n) == cj_error_none);
+    TEST_CHECK(n.i == -7 && n.i64 == -9000000000LL && n.u64 == UINT64_MAX && n.d == 2.5);
+    TEST_CHECK(tpb_numbers_case(&binding, "{\"i64\": 5, \"u64\": 6, \"d\": -9000000000}", &n) == cj_error_none);
+    TEST_CHECK(n.i64 == 5 && n.u64 == 6 && n.d == -9000000000.0);
+
+    TEST_CHECK(tpb_numbers_case(&binding, "{\"i\": 3000000000}", &n) == cj_error_type_mismatch);
+    TEST_CHECK(tpb_numbers_case(&binding, "{\"i\": 1.5}", &n) == cj_error_type_mismatch);
+    TEST_CHECK(tpb_numbers_case(&binding, "{\"i64\": 18446744073709551615}", &n) == cj_error_type_mismatch);
+    TEST_CHECK(tpb_numbers_case(&binding, "{\"u64\": -1}", &n) == cj_error_type_mismatch);
+    TEST_CHECK(tpb_numbers_case(&binding, "{\"d\": \"2.5\"}", &n) == cj_error_type_mismatch);
+
+    cj_binding_free(&binding);
+}
+
+void test_cj_parse_bound_errors() {
+    tpb_init();
+    const char* errors[] = {
+        "[]",
+        "{\"name\": 1}",
+        "{\"done\": \"yes\"}",
+        "{\"progress\": []}",
+        "{\"tags\": {}}",
+        "{\"tags\": [\"a\", \"b\", \"c\", \"d\", \"e\"]}",
+        "{\"tags\": [1]}",
+        "{\"unknown\": [1, }",
+        "{\"name\": \"x\" \"done\": true}",
+        "{\"name\": \"x\",}",
+        "{\"progress\": {\"linesWritten\": 1}",
+    };
+    enum cj_error_code expected[] = {
+        cj_error_exp_open_curly_bracket, cj_error_type_mismatch,  cj_error_type_mismatch,
+        cj_error_type_mismatch,          cj_error_type_mismatch,  cj_error_array_capacity,
+        cj_error_type_mismatch,          cj_error_exp_value,      cj_error_exp_close_curly_bracket,
+        cj_error_exp_quote,              cj_error_exp_close_curly_bracket,
+    };
+    for (size_t i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+        struct tpb_project project = {0};
+        struct cj_error err = cj_parse_bound(&tpb_project_binding, errors[i], strlen(errors[i]), &project);
+        TEST_CHECK_(err.type == expected[i], "'%s' fails with %s", errors[i], cj_error_message[expected[i]].str);
+        cj_bound_free(&tpb_project_binding, &project);
+    }
+
+    // the error points to the value that does not match
+    const char* json = "{\"done\": true,\n \"progress\": {\"linesWritten\": 1e3}}";
+    struct tpb_project project = {0};
+    struct cj_error err = cj_parse_bound(&tpb_project_binding, json, strlen(json), &project);
+    TEST_CHECK(err.type == cj_error_type_mismatch);
+    TEST_CHECK(err.stopped_at == strstr(json, "1e3"));
+    TEST_CHECK(err.line == 1);
+
+    // values of unknown keys are validated as strictly as bound ones
+    json = "{\"zz\": 01, \"done\": true}";
+    project = (struct tpb_project){0};
+    err = cj_parse_bound(&tpb_project_binding, json, strlen(json), &project);
+    TEST_CHECK(err.type == cj_error_exp_close_curly_bracket);
+    TEST_CHECK(err.stopped_at == strstr(json, "1,"));
+    TEST_CHECK(project.done == false);
+    tpb_free();
+
+    // a char array without room for the '\0'
+    struct cj_binding binding;
+    const struct cj_field empty[] = {{.key = "a", .type = cj_field_chars}};
+    TEST_CHECK(cj_binding_init(&binding, empty, 1) == cj_error_invalid_field);
+    const struct cj_field empty_elements[] = {
+        {.key = "a", .type = cj_field_array, .capacity = 1, .element = &empty[0]},
+    };
+    TEST_CHECK(cj_binding_init(&binding, empty_elements, 1) == cj_error_invalid_field);
+}
+
+void test_cj_parse_bound_repeated_array() {
+    tpb_init();
+    // the last array wins, the strings of the items it does not overwrite are freed
+    const char* json = "{\"aliases\": [\"a\", \"b\", \"c\"], \"authors\": [{\"name\": \"x\"}, {\"name\": \"y\"}], "
+                       "\"aliases\": [\"d\"], \"authors\": [{\"name\": \"z\"}]}";
+    struct tpb_project project = {0};
+    TEST_ASSERT(cj_parse_bound(&tpb_project_binding, json, strlen(json), &project).type == cj_error_none);
+    TEST_CHECK(project.aliases_count == 1 && strcmp(project.aliases[0], "d") == 0);
+    TEST_CHECK(project.aliases[1] == NULL && project.aliases[2] == NULL);
+    TEST_CHECK(project.authors_count == 1 && strcmp(project.authors[0].name, "z") == 0);
+    TEST_CHECK(project.authors[1].name == NULL);
+    cj_bound_free(&tpb_project_binding, &project);
+
+    // also if the repeated array fails
+    json = "{\"aliases\": [\"a\", \"b\", \"c\"], \"aliases\": [\"d\", 1]}";
+    project = (struct tpb_project){0};
+    TEST_CHECK(cj_parse_bound(&tpb_project_binding, json, strlen(json), &project).type == cj_error_type_mismatch);
+    TEST_CHECK(project.aliases_count == 1 && project.aliases[1] == NULL && project.aliases[2] == NULL);
+    cj_bound_free(&tpb_project_binding, &project);
+    tpb_free();
+}
@@ -0,0 +1,76 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_BOUNDED                                                   \
+    {"cj_parse_bounded", test_cj_parse_bounded}, {                               \
+        "cj_parse_bounded_prefixes", test_cj_parse_bounded_prefixes              \
+    }
+
+/**
+ * Copy str into a buffer of exactly strlen(str) bytes (no '\0'), so reading past the end is caught by the sanitizers.
+ */
+char* test_cj_parse_bounded_copy(const char* str) {
+    size_t len = strlen(str);
+    char* buffer = malloc(len == 0 ? 1 : len);
+    memcpy(buffer, str, len);
+    return buffer;
+}
+
+void test_cj_parse_bounded() {
+    // parse a slice out of a larger buffer
+    char* frames = "[1, 2, \"three\"]{\"next\": \"frame\"}";
+    struct cj_error err = {0};
+    struct cj_entity* list = cj_decode_n(frames, 15, &err);
+    TEST_ASSERT(list != NULL);
+    TEST_ASSERT(list->type == cj_type_array);
+    TEST_ASSERT(cj_entity_length(list) == 3);
+    TEST_ASSERT(strcmp(cj_entity_as_string(cj_entity_get_item(list, 2)), "three") == 0);
+    cj_entity_free(list);
+
+    struct cj_entity* obj = cj_decode_n(frames + 15, strlen(frames) - 15, &err);
+    TEST_ASSERT(obj != NULL);
+    TEST_ASSERT(strcmp(cj_entity_as_string(cj_entity_get_member(obj, "next")), "frame") == 0);
+    cj_entity_free(obj);
+
+    // the slice ends inside the value
+    TEST_ASSERT(cj_decode_n(frames, 14, &err) == NULL);
+    TEST_ASSERT(err.type == cj_error_exp_close_square_bracket);
+    TEST_ASSERT(cj_decode_n(frames, 10, &err) == NULL);
+    TEST_ASSERT(err.type == cj_error_unexpected_eof);
+
+    char* json = test_cj_parse_bounded_copy("{\"name\": \"value\", \"list\": [true, false, null, -1.5e3]}");
+    struct cj_parser parser = {.open = cj_open_void, .push = cj_push_void, .set = cj_set_void};
+    err = cj_parse_object_into_n(&parser, json, strlen("{\"name\": \"value\", \"list\": [true, false, null, -1.5e3]}"),
+                                 NULL, 0);
+    TEST_ASSERT(err.type == cj_error_none);
+    free(json);
+
+    json = test_cj_parse_bounded_copy("[[], [\"a\"], [1]]");
+    err = cj_parse_array_into_n(&parser, json, strlen("[[], [\"a\"], [1]]"), NULL, 0);
+    TEST_ASSERT(err.type == cj_error_none);
+    free(json);
+}
+
+void test_cj_parse_bounded_prefixes() {
+    // every proper prefix of a document is incomplete and must be rejected without reading past its end
+    const char* doc =
+        "{\"s\": \"t\\u00e4xt \\\"q\\\" \\\\\", \"n\": -12.5e-3, \"i\": 42, \"t\": true, \"f\": false, \"z\": null,"
+        "  \"a\": [1, {\"x\": []}, \"0123456789abcdef0123456789abcdef0123456789abcdef\"]}";
+    size_t len = strlen(doc);
+    for (size_t i = 0; i < len; i++) {
+        char* prefix = test_cj_parse_bounded_copy(doc);
+        struct cj_error err = {0};
+        struct cj_entity* e = cj_decode_n(prefix, i, &err);
+        TEST_CHECK_(e == NULL, "prefix of length %zu", i);
+        TEST_CHECK(err.type != cj_error_none);
+        free(prefix);
+    }
+    char* full = test_cj_parse_bounded_copy(doc);
+    struct cj_entity* e = cj_decode_n(full, len, NULL);
+    TEST_ASSERT(e != NULL);
+    cj_entity_free(e);
+    free(full);
+}
@@ -0,0 +1,129 @@
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_CTX                                                                                  \
+    {"cj_parse_ctx_alloc", test_cj_parse_ctx_alloc}, {"cj_decode_ctx", test_cj_decode_ctx},               \
+        {"cj_parse_ctx_parser", test_cj_parse_ctx_parser}
+
+void test_cj_parse_ctx_alloc() {
+    struct cj_parse_ctx ctx;
+    TEST_ASSERT(cj_parse_ctx_init(&ctx, 0) == cj_error_none);
+    TEST_CHECK(ctx.blocks == NULL);
+
+    char* c = cj_parse_ctx_alloc(&ctx, 1);
+    double* d = cj_parse_ctx_alloc(&ctx, sizeof(double));
+    TEST_ASSERT(c != NULL && d != NULL);
+    TEST_CHECK((uintptr_t)d % _Alignof(max_align_t) == 0);
+    TEST_CHECK((char*)d > c);
+
+    // larger than a block, the blocks are merged by the reset
+    char* big = cj_parse_ctx_alloc(&ctx, 100000);
+    TEST_ASSERT(big != NULL);
+    memset(big, 'x', 100000);
+    TEST_CHECK(ctx.blocks->next != NULL);
+    size_t capacity = ctx.arena_capacity;
+    cj_parse_ctx_reset(&ctx);
+    TEST_CHECK(ctx.blocks != NULL && ctx.blocks->next == NULL);
+    TEST_CHECK(ctx.arena_capacity >= capacity);
+
+    // now everything fits into the first block
+    struct cj_parse_ctx_block* block = ctx.blocks;
+    TEST_CHECK(cj_parse_ctx_alloc(&ctx, 1) != NULL && cj_parse_ctx_alloc(&ctx, 100000) != NULL);
+    TEST_CHECK(ctx.blocks == block);
+    cj_parse_ctx_free(&ctx);
+    TEST_CHECK(ctx.blocks == NULL && ctx.arena_capacity == 0);
+
+    TEST_ASSERT(cj_parse_ctx_init(&ctx, 100) == cj_error_none);
+    TEST_CHECK(ctx.blocks != NULL && ctx.arena_capacity >= 100);
+    cj_parse_ctx_free(&ctx);
+}
+
+void test_cj_decode_ctx() {
+    static char large[8192];
+    char* out = large + sprintf(large, "[");
+    for (int i = 0; i < 400; i++) {
+        out += sprintf(out, "%s\"s\\t%d\"", i == 0 ? "" : ",", i);
+    }
+    sprintf(out, "]");
+    const char* documents[] = {
+        "{\"name\":\"My \\\"Project\\\"\",\"progress\":{\"linesWritten\":628},\"tags\":[\"writing\",\"book\"],"
+        "\"metadata\":null,\"done\":true}",
+        large,
+        "\"a string\"",
+        "[]",
+    };
+
+    struct cj_parse_ctx ctx;
+    TEST_ASSERT(cj_parse_ctx_init(&ctx, 0) == cj_error_none);
+    struct cj_parse_ctx_block* warm = NULL;
+    for (int round = 0; round < 3; round++) {
+        for (size_t i = 0; i < sizeof(documents) / sizeof(documents[0]); i++) {
+            struct cj_error err;
+            struct cj_entity* e = cj_decode_ctx(&ctx, documents[i], strlen(documents[i]), 0, &err);
+            TEST_ASSERT(e != NULL && err.type == cj_error_none);
+            char* encoded = cj_encode(e);
+            TEST_CHECK_(strcmp(encoded, documents[i]) == 0, "document %zu in round %d", i, round);
+            free(encoded);
+            cj_parse_ctx_reset(&ctx);
+        }
+        // after the first round the arena does not grow any more
+        if (round == 1) {
+            warm = ctx.blocks;
+        }
+        TEST_CHECK(ctx.blocks != NULL && ctx.blocks->next == NULL);
+    }
+    TEST_CHECK(ctx.blocks == warm);
+
+    struct cj_error err;
+    TEST_CHECK(cj_decode_ctx(&ctx, "{\"a\": [1, 2}", 12, 0, &err) == NULL);
+    TEST_CHECK(err.type == cj_error_exp_close_square_bracket);
+    cj_parse_ctx_free(&ctx);
+}
+
+enum cj_error_code tpc_push_batch(void* this, unsigned int tag, size_t index, struct cj_value* values, size_t count) {
+    (void)this;
+    (void)tag;
+    (void)index;
+    (void)values;
+    (void)count;
+    return cj_error_none;
+}
+
+void test_cj_parse_ctx_parser() {
+    // deeper than the frames inside of the stack
+    char json[512];
+    memset(json, '[', 100);
+    memset(json + 100, ']', 100);
+    json[200] = '\0';
+
+    struct cj_parse_ctx ctx;
+    TEST_ASSERT(cj_parse_ctx_init(&ctx, 0) == cj_error_none);
+    struct cj_parser parser = {.open = cj_open_void, .push = cj_push_void, .set = cj_set_void, .ctx = &ctx};
+    TEST_ASSERT(cj_parse_array_into_n(&parser, json, 200, NULL, 0).type == cj_error_none);
+    void* frames = ctx.frames;
+    TEST_CHECK(frames != NULL && ctx.frames_capacity >= 100);
+
+    // the memory of the first documents is reused, also after errors
+    for (int i = 0; i < 3; i++) {
+        TEST_CHECK(cj_parse_array_into_n(&parser, json, 200, NULL, 0).type == cj_error_none);
+        TEST_CHECK(cj_parse_array_into_n(&parser, json, 199, NULL, 0).type != cj_error_none);
+        TEST_CHECK(ctx.frames == frames);
+    }
+    TEST_CHECK(ctx.batch == NULL);
+
+    // the push_batch buffer is only allocated with push_batch and then kept as well
+    parser.push_batch = tpc_push_batch;
+    TEST_ASSERT(cj_parse_array_into_n(&parser, "[1, [2, 3]]", 11, NULL, 0).type == cj_error_none);
+    struct cj_value* batch = ctx.batch;
+    TEST_CHECK(batch != NULL);
+    TEST_CHECK(cj_parse_array_into_n(&parser, "[1, [2, 3]", 10, NULL, 0).type != cj_error_none);
+    TEST_CHECK(ctx.batch == batch);
+    cj_parse_ctx_free(&ctx);
+    TEST_CHECK(ctx.frames == NULL && ctx.batch == NULL);
+}
@@ -0,0 +1,84 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_DEPTH {"cj_parse_depth", test_cj_parse_depth}, {"cj_parse_depth_deep", test_cj_parse_depth_deep}
+
+size_t ptd_opened;
+
+enum cj_error_code ptd_open(enum cj_container_type type, void* parent, unsigned int parent_tag, union cj_key* key,
+                            void** open, unsigned int* tag) {
+    ptd_opened++;
+    return cj_open_void(type, parent, parent_tag, key, open, tag);
+}
+
+/**
+ * Build depth nested arrays around a single number, if object is true every other level is an object.
+ */
+char* ptd_nested(size_t depth, bool object) {
+    char* json = malloc(depth * 6 + 2);
+    char* out = json;
+    for (size_t i = 0; i < depth; i++) {
+        if (object && i % 2 == 1) {
+            memcpy(out, "{\"k\":", 5);
+            out += 5;
+        } else {
+            *out++ = '[';
+        }
+    }
+    *out++ = '1';
+    for (size_t i = depth; i > 0; i--) {
+        *out++ = object && (i - 1) % 2 == 1 ? '}' : ']';
+    }
+    *out = '\0';
+    return json;
+}
+
+void test_cj_parse_depth() {
+    struct cj_parser parser = {.open = ptd_open, .push = cj_push_void, .set = cj_set_void, .max_depth = 8};
+    struct cj_error err;
+
+    for (int object = 0; object < 2; object++) {
+        char* json = ptd_nested(8, object);
+        ptd_opened = 0;
+        err = cj_parse_array_into(&parser, json, NULL, 0);
+        TEST_CHECK(err.type == cj_error_none);
+        TEST_CHECK(ptd_opened == 7);
+        free(json);
+
+        json = ptd_nested(9, object);
+        ptd_opened = 0;
+        err = cj_parse_array_into(&parser, json, NULL, 0);
+        TEST_CHECK(err.type == cj_error_max_depth);
+        // the rejected container is never opened
+        TEST_CHECK(ptd_opened == 7);
+        // stopped at the ninth opening bracket
+        TEST_CHECK(err.stopped_at == json + (object ? 4 + 4 * 5 : 8));
+        free(json);
+    }
+
+    // white space in empty containers and trailing commas
+    parser.max_depth = 0;
+    TEST_CHECK(cj_parse_object_into(&parser, "{ }", NULL, 0).type == cj_error_none);
+    TEST_CHECK(cj_parse_array_into(&parser, "[ \n\t ]", NULL, 0).type == cj_error_none);
+    TEST_CHECK(cj_parse_object_into(&parser, "{ \"a\" : [ ] , \"b\" : { } }", NULL, 0).type == cj_error_none);
+    TEST_CHECK(cj_parse_object_into(&parser, "{\"a\":1,}", NULL, 0).type == cj_error_exp_quote);
+    TEST_CHECK(cj_parse_array_into(&parser, "[1, ]", NULL, 0).type == cj_error_exp_value);
+    TEST_CHECK(cj_parse_array_into(&parser, "[", NULL, 0).type == cj_error_unexpected_eof);
+}
+
+void test_cj_parse_depth_deep() {
+    // deep enough to overflow a small thread stack with a recursive parser
+    size_t depth = 1000000;
+    char* json = ptd_nested(depth, true);
+    struct cj_parser parser = {.open = cj_open_void, .push = cj_push_void, .set = cj_set_void};
+
+    TEST_CHECK(cj_parse_array_into(&parser, json, NULL, 0).type == cj_error_max_depth);
+    TEST_CHECK(cj_decode(json, NULL) == NULL);
+
+    parser.max_depth = depth;
+    TEST_CHECK(cj_parse_array_into(&parser, json, NULL, 0).type == cj_error_none);
+    free(json);
+}
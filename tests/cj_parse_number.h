@@ -1,18 +1,23 @@
 #include "../cj.h"
+#include <math.h>
 #include "acutest.h"
 
-#define CJ_TESTS_PARSE_NUMBER {"cj_parse_number", test_cj_parse_number}
+#define CJ_TESTS_PARSE_NUMBER                                                                                  \
+    {"cj_parse_number", test_cj_parse_number},                                                                 \
+        {"cj_parse_number integer range", test_cj_parse_number_integer_range},                                 \
+        {"cj_parse_decimal", test_cj_parse_decimal}, {"cj_parse lazy numbers", test_cj_parse_lazy_numbers},                     \
+        {"cj_parse_number eight digits", test_cj_parse_number_eight_digits}
 
 enum cj_error_code test_cj_parse_number_case_d(char* data, double* number) {
     struct cj_value value;
-    enum cj_error_code err = cj_parse_number(&data, &value);
-    *number = value.number.decimal;
+    enum cj_error_code err = cj_parse_number(&data, data + strlen(data), &value);
+    *number = value.number.decimal64;
     return err;
 }
 
 enum cj_error_code test_cj_parse_number_case_i(char* data, int* number) {
     struct cj_value value;
-    enum cj_error_code err = cj_parse_number(&data, &value);
+    enum cj_error_code err = cj_parse_number(&data, data + strlen(data), &value);
     *number = value.number.integer;
     return err;
 }
@@ -31,19 +36,214 @@ void test_cj_parse_number() {
     TEST_ASSERT(test_cj_parse_number_case_d("-0.0e-", &dval) == cj_error_exp_digits);
     TEST_ASSERT(test_cj_parse_number_case_d("-0.0e-0", &dval) == cj_error_none);
 
-    TEST_ASSERT(test_cj_parse_number_case_d("0", &dval) == cj_error_none);
-    TEST_ASSERT(dval == 0.);
+    TEST_ASSERT(test_cj_parse_number_case_i("0", &ival) == cj_error_none);
+    TEST_ASSERT(ival == 0);
     TEST_ASSERT(test_cj_parse_number_case_i("1", &ival) == cj_error_none);
     TEST_ASSERT(ival == 1);
     TEST_ASSERT(test_cj_parse_number_case_i("-1", &ival) == cj_error_none);
     TEST_ASSERT(ival == -1.);
     TEST_ASSERT(test_cj_parse_number_case_d("0.2", &dval) == cj_error_none);
-    TEST_ASSERT(dval == .2f);
+    TEST_ASSERT(dval == .2);
     TEST_ASSERT(test_cj_parse_number_case_d("-0.2", &dval) == cj_error_none);
-    TEST_ASSERT(dval == -.2f);
+    TEST_ASSERT(dval == -.2);
     TEST_ASSERT(test_cj_parse_number_case_d("-0.2e2", &dval) == cj_error_none);
-    TEST_ASSERT(dval == -20.f);
+    TEST_ASSERT(dval == -20.);
     TEST_ASSERT(test_cj_parse_number_case_d("-0.2e-2", &dval) == cj_error_none);
-    TEST_ASSERT(dval == -.002f);
+    TEST_ASSERT(dval == -.002);
 }
 
+void test_cj_parse_number_integer_range() {
+    int ival;
+    double dval;
+    struct cj_value value;
+
+    TEST_ASSERT(test_cj_parse_number_case_i("2147483647", &ival) == cj_error_none);
+    TEST_ASSERT(ival == INT_MAX);
+    TEST_ASSERT(test_cj_parse_number_case_i("-2147483648", &ival) == cj_error_none);
+    TEST_ASSERT(ival == INT_MIN);
+    TEST_ASSERT(test_cj_parse_number_case_i("-0", &ival) == cj_error_none);
+    TEST_ASSERT(ival == 0);
+
+    // wider integers are parsed into the narrowest 64 bit type, beyond that as decimals
+    char* data = "2147483648";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_integer64);
+    TEST_ASSERT(value.number.integer64 == 2147483648);
+    TEST_ASSERT(*data == '\0');
+    data = "-2147483649";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_integer64);
+    TEST_ASSERT(value.number.integer64 == -2147483649);
+    data = "-9223372036854775808";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_integer64);
+    TEST_ASSERT(value.number.integer64 == INT64_MIN);
+    data = "9223372036854775808";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_uinteger64);
+    TEST_ASSERT(value.number.uinteger64 == 9223372036854775808ULL);
+    data = "18446744073709551615";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_uinteger64);
+    TEST_ASSERT(value.number.uinteger64 == UINT64_MAX);
+    data = "18446744073709551616";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_decimal64);
+    TEST_ASSERT(value.number.decimal64 == 18446744073709551616.);
+    data = "-12345678901234567890,";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_decimal64);
+    TEST_ASSERT(value.number.decimal64 == -12345678901234567890.);
+    TEST_ASSERT(*data == ',');
+
+    // the number ends at the first character which can not continue it
+    data = "01";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_integer && value.number.integer == 0);
+    TEST_ASSERT(*data == '1');
+    data = "123456";
+    TEST_ASSERT(cj_parse_number(&data, data + 3, &value) == cj_error_none);
+    TEST_ASSERT(value.number.integer == 123);
+    TEST_ASSERT(test_cj_parse_number_case_d("12e", &dval) == cj_error_exp_digits);
+}
+
+bool test_cj_parse_decimal_case(char* data, double expected) {
+    double value;
+    char* b = data;
+    if (cj_parse_decimal(&b, data + strlen(data), &value) != cj_error_none || b != data + strlen(data)) {
+        return false;
+    }
+    return memcmp(&value, &expected, sizeof(double)) == 0;
+}
+
+void test_cj_parse_decimal() {
+    // exact fast path
+    TEST_ASSERT(test_cj_parse_decimal_case("7.2", 7.2));
+    TEST_ASSERT(test_cj_parse_decimal_case("-0.2e-2", -0.002));
+    TEST_ASSERT(test_cj_parse_decimal_case("-0.0", -0.0));
+    TEST_ASSERT(test_cj_parse_decimal_case("1e22", 1e22));
+    // Eisel-Lemire
+    TEST_ASSERT(test_cj_parse_decimal_case("1e23", 1e23));
+    TEST_ASSERT(test_cj_parse_decimal_case("1.7976931348623157e308", 1.7976931348623157e308));
+    TEST_ASSERT(test_cj_parse_decimal_case("2.2250738585072014e-308", 2.2250738585072014e-308));
+    TEST_ASSERT(test_cj_parse_decimal_case("4.9e-324", 4.9e-324));
+    TEST_ASSERT(test_cj_parse_decimal_case("9007199254740993", 9007199254740992.));
+    TEST_ASSERT(test_cj_parse_decimal_case("0.000000000000000000000000000000123456789", 1.23456789e-31));
+    // out of range
+    TEST_ASSERT(test_cj_parse_decimal_case("1e309", HUGE_VAL));
+    TEST_ASSERT(test_cj_parse_decimal_case("-1e99999999999", -HUGE_VAL));
+    TEST_ASSERT(test_cj_parse_decimal_case("1e-400", 0.0));
+    // more than 19 significant digits, the last ones decide the rounding
+    char* halfway = "1.00000000000000011102230246251565404236316680908203125";
+    char* above_halfway = "1.00000000000000011102230246251565404236316680908203126";
+    TEST_ASSERT(test_cj_parse_decimal_case(halfway, 1.0));
+    TEST_ASSERT(test_cj_parse_decimal_case(above_halfway, 1.0000000000000002));
+    TEST_ASSERT(test_cj_parse_decimal_case("9007199254740993.0000000000000000001", 9007199254740994.));
+    // just below and just above half of the smallest subnormal
+    char* below = "2.47032822920623272088284396434110686182529901307162382212792841250337753635104375932649918180e-324";
+    char* above = "2.47032822920623272088284396434110686182529901307162382212792841250337753635104375932649918181e-324";
+    TEST_ASSERT(test_cj_parse_decimal_case(below, 0.0));
+    TEST_ASSERT(test_cj_parse_decimal_case(above, 4.9e-324));
+}
+
+struct cj_numeric ptn_lazy_numbers[4];
+size_t ptn_lazy_count;
+
+enum cj_error_code ptn_lazy_push(void* this, unsigned int tag, size_t index, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    (void)index;
+    if (value->type == cj_type_number && ptn_lazy_count < 4) {
+        ptn_lazy_numbers[ptn_lazy_count++] = value->number;
+    }
+    return cj_error_none;
+}
+
+void test_cj_parse_lazy_numbers() {
+    char* json = "[1, -2.5e3, 123456789012345678901234567890, \"7\"]";
+    struct cj_parser parser = {
+        .open = cj_open_void, .push = ptn_lazy_push, .set = cj_set_void, .flags = cj_parse_lazy_numbers};
+
+    ptn_lazy_count = 0;
+    struct cj_error err = cj_parse_array_into_n(&parser, json, strlen(json), NULL, 0);
+    TEST_ASSERT(err.type == cj_error_none);
+    TEST_ASSERT(ptn_lazy_count == 3);
+
+    // the texts point into the input and keep every digit
+    TEST_ASSERT(ptn_lazy_numbers[0].type == cj_numeric_type_integer_span);
+    TEST_ASSERT(ptn_lazy_numbers[0].text.ptr == json + 1 && ptn_lazy_numbers[0].text.length == 1);
+    TEST_ASSERT(ptn_lazy_numbers[1].type == cj_numeric_type_decimal_span);
+    TEST_ASSERT(ptn_lazy_numbers[1].text.length == 6 && memcmp(ptn_lazy_numbers[1].text.ptr, "-2.5e3", 6) == 0);
+    TEST_ASSERT(ptn_lazy_numbers[2].type == cj_numeric_type_integer_span);
+    TEST_ASSERT(ptn_lazy_numbers[2].text.length == 30);
+
+    struct cj_numeric n = {0};
+    TEST_ASSERT(cj_numeric_from_text(ptn_lazy_numbers[0].text.ptr, 1, &n) == cj_error_none);
+    TEST_ASSERT(n.type == cj_numeric_type_integer && n.integer == 1);
+    TEST_ASSERT(cj_numeric_from_text(ptn_lazy_numbers[1].text.ptr, 6, &n) == cj_error_none);
+    TEST_ASSERT(n.type == cj_numeric_type_decimal64 && n.decimal64 == -2500.);
+    TEST_ASSERT(cj_numeric_from_text(ptn_lazy_numbers[2].text.ptr, 30, &n) == cj_error_none);
+    TEST_ASSERT(n.type == cj_numeric_type_decimal64 && n.decimal64 == 123456789012345678901234567890.);
+
+    // lazy numbers reject the same input as the eager parser
+    const char* leading_zeros[] = {"[01]", "[1, -00]"};
+    for (size_t i = 0; i < 2; i++) {
+        struct cj_parser eager = {.open = cj_open_void, .push = cj_push_void, .set = cj_set_void};
+        struct cj_error expected = cj_parse_array_into_n(&eager, leading_zeros[i], strlen(leading_zeros[i]), NULL, 0);
+        struct cj_error err = cj_parse_array_into_n(&parser, leading_zeros[i], strlen(leading_zeros[i]), NULL, 0);
+        TEST_CHECK_(err.type == cj_error_exp_close_square_bracket && err.type == expected.type &&
+                        err.stopped_at == expected.stopped_at,
+                    "'%s' is rejected", leading_zeros[i]);
+    }
+
+    // only a complete number converts, out keeps its value otherwise
+    n = cj_numeric_integer(7);
+    TEST_CHECK(cj_numeric_from_text("12x", 3, &n) == cj_error_unexpected_input);
+    TEST_CHECK(cj_numeric_from_text("-", 1, &n) == cj_error_exp_digits);
+    TEST_CHECK(cj_numeric_from_text("", 0, &n) != cj_error_none);
+    TEST_CHECK(n.type == cj_numeric_type_integer && n.integer == 7);
+    TEST_CHECK(cj_numeric_from_text("0", 1, &n) == cj_error_none && n.integer == 0);
+
+    // the encoder writes the text unchanged
+    struct cj_encoder enc;
+    cj_encoder_init(&enc);
+    cj_encoder_push_numeric(&enc, ptn_lazy_numbers[2]);
+    char* encoded = cj_encoder_collapse(&enc);
+    TEST_ASSERT(strcmp(encoded, "123456789012345678901234567890") == 0);
+    free(encoded);
+}
+
+void test_cj_parse_number_eight_digits() {
+    TEST_ASSERT(cju_is_8_digits(cju_load_8("01234567")));
+    TEST_ASSERT(cju_is_8_digits(cju_load_8("99999999")));
+    TEST_ASSERT(!cju_is_8_digits(cju_load_8("1234567/")));
+    TEST_ASSERT(!cju_is_8_digits(cju_load_8(":1234567")));
+    TEST_ASSERT(!cju_is_8_digits(cju_load_8("1234.567")));
+    TEST_ASSERT(!cju_is_8_digits(cju_load_8("1234\xb0" "567")));
+    TEST_ASSERT(cju_parse_8_digits(cju_load_8("01234567")) == 1234567);
+    TEST_ASSERT(cju_parse_8_digits(cju_load_8("99999999")) == 99999999);
+
+    // chunks must not run past the end of the number or the end of the input
+    struct cj_value value;
+    char* data = "1700000000123,";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_integer64 && value.number.integer64 == 1700000000123);
+    TEST_ASSERT(*data == ',');
+    data = "1234567812345678";
+    TEST_ASSERT(cj_parse_number(&data, data + 12, &value) == cj_error_none);
+    TEST_ASSERT(value.number.integer64 == 123456781234);
+    data = "-9223372036854775809";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.type == cj_numeric_type_decimal64 && value.number.decimal64 == -9223372036854775809.);
+    data = "1844674407370955161";
+    TEST_ASSERT(cj_parse_number(&data, data + strlen(data), &value) == cj_error_none);
+    TEST_ASSERT(value.number.uinteger64 == 1844674407370955161ULL);
+
+    double dval;
+    TEST_ASSERT(test_cj_parse_number_case_d("1700000000.123456789", &dval) == cj_error_none);
+    TEST_ASSERT(dval == 1700000000.123456789);
+    TEST_ASSERT(test_cj_parse_number_case_d("0.1234567890123456789012", &dval) == cj_error_none);
+    TEST_ASSERT(dval == 0.1234567890123456789012);
+    TEST_ASSERT(test_cj_parse_number_case_d("12345678.00000000000000000001e-3", &dval) == cj_error_none);
+    TEST_ASSERT(dval == 12345.678);
+}
@@ -0,0 +1,133 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_NUMBER_ARRAY                                                                    \
+    {"cj_parse_number_array_into", test_cj_parse_number_array_into},                                 \
+        {"cj_parse_number_array_errors", test_cj_parse_number_array_errors},                         \
+        {"cj_parse_number_array_open", test_cj_parse_number_array_open}
+
+void test_cj_parse_number_array_into() {
+    double doubles[8];
+    struct cj_number_array array = {.type = cj_number_array_double, .values = doubles, .capacity = 8};
+    const char* json = " [1.5, -2,3e2 , 18446744073709551615, -9000000000, 0]";
+    struct cj_error err = cj_parse_number_array_into(json, strlen(json), &array);
+    TEST_ASSERT(err.type == cj_error_none);
+    TEST_CHECK(err.stopped_at == json + strlen(json));
+    TEST_CHECK(array.count == 6);
+    TEST_CHECK(doubles[0] == 1.5 && doubles[1] == -2.0 && doubles[2] == 300.0);
+    TEST_CHECK(doubles[3] == 18446744073709551615.0 && doubles[4] == -9000000000.0 && doubles[5] == 0.0);
+
+    int64_t integers[4];
+    array = (struct cj_number_array){.type = cj_number_array_int64, .values = integers, .capacity = 4};
+    json = "[1, -9000000000, 9223372036854775807, -9223372036854775808]";
+    TEST_ASSERT(cj_parse_number_array_into(json, strlen(json), &array).type == cj_error_none);
+    TEST_CHECK(array.count == 4);
+    TEST_CHECK(integers[0] == 1 && integers[1] == -9000000000LL && integers[2] == INT64_MAX &&
+               integers[3] == INT64_MIN);
+
+    json = "[ ]";
+    TEST_ASSERT(cj_parse_number_array_into(json, strlen(json), &array).type == cj_error_none);
+    TEST_CHECK(array.count == 0);
+
+    // exactly as many numbers as fit
+    array.capacity = 2;
+    json = "[1,2]";
+    TEST_ASSERT(cj_parse_number_array_into(json, strlen(json), &array).type == cj_error_none);
+    TEST_CHECK(array.count == 2);
+}
+
+void test_cj_parse_number_array_errors() {
+    int64_t integers[2];
+    struct cj_number_array array = {.type = cj_number_array_int64, .values = integers, .capacity = 2};
+    const char* errors[] = {"{}", "[1, \"2\"]", "[1.5]", "[9223372036854775808]", "[1, 2, 3]",
+                            "[1,]", "[1 2]", "[1", "[-]", "[[1]]"};
+    enum cj_error_code expected[] = {cj_error_exp_open_square_bracket,
+                                     cj_error_type_mismatch,
+                                     cj_error_type_mismatch,
+                                     cj_error_type_mismatch,
+                                     cj_error_array_capacity,
+                                     cj_error_exp_value,
+                                     cj_error_exp_close_square_bracket,
+                                     cj_error_exp_close_square_bracket,
+                                     cj_error_exp_digits,
+                                     cj_error_type_mismatch};
+    // position of the error
+    size_t at[] = {0, 4, 1, 1, 7, 3, 3, 2, 2, 1};
+    for (size_t i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+        struct cj_error err = cj_parse_number_array_into(errors[i], strlen(errors[i]), &array);
+        TEST_CHECK_(err.type == expected[i], "'%s' fails with %s", errors[i], cj_error_message[expected[i]].str);
+        TEST_CHECK_(err.stopped_at == errors[i] + at[i], "'%s' fails at %zu", errors[i], at[i]);
+    }
+}
+
+// The values of the objects in the root array are parsed into number arrays, the root counts the pushes it receives.
+struct tpna_series {
+    double values[4];
+    struct cj_number_array array;
+};
+
+struct tpna_root {
+    struct tpna_series series[2];
+    size_t count;
+    size_t pushes;
+};
+
+enum cj_error_code tpna_open(enum cj_container_type type, void* parent, unsigned int parent_tag, union cj_key* key,
+                             void** open, unsigned int* tag) {
+    (void)type;
+    struct tpna_root* root = parent;
+    if (parent_tag == 0) {
+        *open = &root->series[root->count++];
+        *tag = 1;
+        return cj_error_none;
+    }
+    struct tpna_series* series = parent;
+    if (parent_tag == 1 && cj_span_eq(&key->id, "values")) {
+        series->array =
+            (struct cj_number_array){.type = cj_number_array_double, .values = series->values, .capacity = 4};
+        *open = &series->array;
+        return cj_error_number_array;
+    }
+    return cj_error_skip;
+}
+
+enum cj_error_code tpna_push(void* this, unsigned int tag, size_t index, struct cj_value* value) {
+    (void)tag;
+    (void)index;
+    (void)value;
+    ((struct tpna_root*)this)->pushes++;
+    return cj_error_none;
+}
+
+enum cj_error_code tpna_set(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
+    (void)tag;
+    struct tpna_series* series = this;
+    // the parent receives the number array itself
+    if (cj_span_eq(id, "values") && (value->type != cj_type_array || value->array != &series->array)) {
+        return cj_error_unexpected_input;
+    }
+    return cj_error_none;
+}
+
+void test_cj_parse_number_array_open() {
+    struct cj_parser parser = {.open = tpna_open, .push = tpna_push, .set = tpna_set};
+    const char* json = "[{\"values\": [1, 2.5, -3], \"other\": [1], \"name\": \"a\"}, {\"values\": [],\"x\":1}]";
+
+    struct tpna_root root = {0};
+    struct cj_error err = cj_parse_array_into_n(&parser, json, strlen(json), &root, 0);
+    TEST_ASSERT(err.type == cj_error_none);
+    TEST_CHECK(root.count == 2);
+    TEST_CHECK(root.pushes == 2);
+    TEST_CHECK(root.series[0].array.count == 3);
+    TEST_CHECK(root.series[0].values[0] == 1.0 && root.series[0].values[1] == 2.5 && root.series[0].values[2] == -3.0);
+    TEST_CHECK(root.series[1].array.count == 0);
+
+    const char* overflow = "[{\"values\": [1, 2, 3, 4, 5]}]";
+    root = (struct tpna_root){0};
+    err = cj_parse_array_into_n(&parser, overflow, strlen(overflow), &root, 0);
+    TEST_CHECK(err.type == cj_error_array_capacity);
+    TEST_CHECK(err.stopped_at == strstr(overflow, "5"));
+}
@@ -0,0 +1,156 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_PUSH_BATCH \
+    {"cj_parse_push_batch", test_cj_parse_push_batch}, {"cj_parse_push_batch_large", test_cj_parse_push_batch_large}
+
+// Every callback is logged, push and push_batch log each value as "<tag>.<index>=<value>" so a parser with and without
+// push_batch must produce the same log. Containers are opened with the tag of their depth.
+char tppb_log[1024];
+size_t tppb_batches;
+
+void tppb_log_value(unsigned int tag, size_t index, struct cj_value* value) {
+    char* out = tppb_log + strlen(tppb_log);
+    switch (value->type) {
+        case cj_type_number:
+            sprintf(out, "%u.%zu=%d ", tag, index, value->number.integer);
+            break;
+        case cj_type_string:
+            sprintf(out, "%u.%zu=s%zu ", tag, index, cj_span_len(&value->string));
+            break;
+        case cj_type_bool:
+        case cj_type_null:
+            sprintf(out, "%u.%zu=l ", tag, index);
+            break;
+        default:
+            sprintf(out, "%u.%zu=c ", tag, index);
+    }
+}
+
+enum cj_error_code tppb_open(enum cj_container_type type, void* parent, unsigned int parent_tag, union cj_key* key,
+                             void** open, unsigned int* tag) {
+    (void)type;
+    (void)parent;
+    (void)key;
+    *open = NULL;
+    *tag = parent_tag + 1;
+    sprintf(tppb_log + strlen(tppb_log), "open%u ", *tag);
+    return cj_error_none;
+}
+
+enum cj_error_code tppb_push(void* this, unsigned int tag, size_t index, struct cj_value* value) {
+    (void)this;
+    tppb_log_value(tag, index, value);
+    return cj_error_none;
+}
+
+enum cj_error_code tppb_push_batch(void* this, unsigned int tag, size_t index, struct cj_value* values, size_t count) {
+    (void)this;
+    tppb_batches++;
+    for (size_t i = 0; i < count; i++) {
+        tppb_log_value(tag, index + i, &values[i]);
+    }
+    return cj_error_none;
+}
+
+enum cj_error_code tppb_set(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
+    (void)this;
+    (void)id;
+    tppb_log_value(tag, 0, value);
+    return cj_error_none;
+}
+
+void test_cj_parse_push_batch() {
+    const char* json = "[1, 2, \"abc\", [3, [], {\"x\": [4, 5]}, 6], true, null, {\"y\": 7}, [[8]], 9]";
+    struct cj_parser parser = {.open = tppb_open, .push = tppb_push, .set = tppb_set};
+
+    char expected[1024] = "";
+    tppb_log[0] = '\0';
+    TEST_ASSERT(cj_parse_array_into_n(&parser, json, strlen(json), NULL, 0).type == cj_error_none);
+    strcpy(expected, tppb_log);
+
+    parser.push_batch = tppb_push_batch;
+    tppb_log[0] = '\0';
+    tppb_batches = 0;
+    TEST_ASSERT(cj_parse_array_into_n(&parser, json, strlen(json), NULL, 0).type == cj_error_none);
+    TEST_CHECK(strcmp(tppb_log, expected) == 0);
+    TEST_MSG("expected: %s\ngot:      %s", expected, tppb_log);
+    // [1, 2, "abc"], [3], [4, 5], [6], [true, null], [8], [9]
+    TEST_CHECK(tppb_batches == 7);
+
+    // malformed arrays fail with the same error at the same position with and without push_batch
+    const char* errors[] = {"[1,]", "[1, 2", "[1,", "[1 2]", "[1, x]", "[\"a\", tru]", "[1, [2,], 3]", "[1, 2}"};
+    for (size_t i = 0; i < sizeof(errors) / sizeof(errors[0]); i++) {
+        parser.push_batch = NULL;
+        struct cj_error expected_err = cj_parse_array_into_n(&parser, errors[i], strlen(errors[i]), NULL, 0);
+        parser.push_batch = tppb_push_batch;
+        struct cj_error err = cj_parse_array_into_n(&parser, errors[i], strlen(errors[i]), NULL, 0);
+        TEST_CHECK_(err.type != cj_error_none && err.type == expected_err.type &&
+                        err.stopped_at == expected_err.stopped_at,
+                    "'%s' fails with %s", errors[i], cj_error_message[expected_err.type].str);
+    }
+}
+
+struct tppb_sum {
+    long long sum;
+    size_t next;
+    size_t max_count;
+    size_t fail_at;
+};
+
+enum cj_error_code tppb_sum_batch(void* this, unsigned int tag, size_t index, struct cj_value* values, size_t count) {
+    (void)tag;
+    struct tppb_sum* sum = this;
+    if (index != sum->next) {
+        return cj_error_unexpected_input;
+    }
+    for (size_t i = 0; i < count; i++) {
+        sum->sum += values[i].number.integer;
+    }
+    sum->next += count;
+    sum->max_count = count > sum->max_count ? count : sum->max_count;
+    return sum->next > sum->fail_at ? cj_error_out_of_memory : cj_error_none;
+}
+
+enum cj_error_code tppb_mismatch_batch(void* this, unsigned int tag, size_t index, struct cj_value* values,
+                                       size_t count) {
+    (void)this;
+    (void)tag;
+    (void)index;
+    (void)values;
+    (void)count;
+    return cj_error_type_mismatch;
+}
+
+void test_cj_parse_push_batch_large() {
+    size_t n = CJ_PUSH_BATCH * 10 + 3;
+    char* json = malloc(n * 8 + 3);
+    char* out = json + sprintf(json, "[");
+    for (size_t i = 0; i < n; i++) {
+        out += sprintf(out, "%s%zu", i == 0 ? "" : ",", i);
+    }
+    sprintf(out, "]");
+
+    struct cj_parser parser = {
+        .open = cj_open_void, .push = cj_push_void, .set = cj_set_void, .push_batch = tppb_sum_batch};
+    struct tppb_sum sum = {.fail_at = SIZE_MAX};
+    TEST_ASSERT(cj_parse_array_into(&parser, json, &sum, 0).type == cj_error_none);
+    TEST_CHECK(sum.next == n);
+    TEST_CHECK(sum.sum == (long long)(n * (n - 1) / 2));
+    TEST_CHECK(sum.max_count == CJ_PUSH_BATCH);
+
+    // errors returned by push_batch stop the parser
+    sum = (struct tppb_sum){.fail_at = CJ_PUSH_BATCH * 2 - 1};
+    TEST_CHECK(cj_parse_array_into(&parser, json, &sum, 0).type == cj_error_out_of_memory);
+    TEST_CHECK(sum.next == CJ_PUSH_BATCH * 2);
+    free(json);
+
+    // also when the batch is handed over while the root array closes
+    parser.push_batch = tppb_mismatch_batch;
+    TEST_CHECK(cj_parse_array_into_n(&parser, "[1,2]", 5, NULL, 0).type == cj_error_type_mismatch);
+}
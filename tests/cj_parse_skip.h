@@ -0,0 +1,106 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_SKIP {"cj_parse_skip", test_cj_parse_skip}
+
+size_t pts_skip_calls;
+
+/**
+ * Skip every container stored under the keys "skip" and "a" and every container in an array at index 1.
+ */
+enum cj_error_code pts_skip_open(enum cj_container_type type, void* parent, unsigned int parent_tag, union cj_key* key,
+                                 void** open, unsigned int* tag) {
+    (void)type;
+    (void)parent;
+    pts_skip_calls++;
+    if (parent_tag == 1 && ((key->id.length == 6 && memcmp(key->id.ptr, "\"skip\"", 6) == 0) ||
+                            (key->id.length == 3 && memcmp(key->id.ptr, "\"a\"", 3) == 0))) {
+        return cj_error_skip;
+    }
+    if (parent_tag == 2 && key->index == 1) {
+        return cj_error_skip;
+    }
+    *open = NULL;
+    *tag = type == cj_container_object ? 1 : 2;
+    return cj_error_none;
+}
+
+enum cj_error_code pts_skip_push(void* this, unsigned int tag, size_t index, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    (void)index;
+    (void)value;
+    pts_skip_calls++;
+    return cj_error_none;
+}
+
+enum cj_error_code pts_skip_set(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    (void)value;
+    pts_skip_calls++;
+    TEST_CHECK_(id->length != 6 || memcmp(id->ptr, "\"skip\"", 6) != 0, "skipped container is not set");
+    return cj_error_none;
+}
+
+enum cj_error_code pts_skip_parse(const char* json, size_t* calls) {
+    struct cj_parser parser = {.open = pts_skip_open, .push = pts_skip_push, .set = pts_skip_set};
+    pts_skip_calls = 0;
+    struct cj_error err = cj_parse_object_into_n(&parser, json, strlen(json), NULL, 1);
+    *calls = pts_skip_calls;
+    return err.type;
+}
+
+void test_cj_parse_skip() {
+    size_t calls;
+
+    // open "skip" (1) + set "a" (1)
+    TEST_CHECK(pts_skip_parse("{\"skip\": {\"x\": [1, 2, {\"y\": 3}]}, \"a\": 1}", &calls) == cj_error_none);
+    TEST_CHECK(calls == 2);
+
+    // brackets and escaped quotes inside of strings do not end the skipped container
+    TEST_CHECK(pts_skip_parse("{\"skip\": [\"]}\", \"\\\"]\", \"\\\\\", {\"}\": \"[\"}], \"a\": 1}", &calls) ==
+               cj_error_none);
+    TEST_CHECK(calls == 2);
+
+    // open "l" + push 0 + open 1 (skipped) + push 2 + set "l"
+    TEST_CHECK(pts_skip_parse("{\"l\": [0, [1, [2]], 2]}", &calls) == cj_error_none);
+    TEST_CHECK(calls == 5);
+
+    // empty and nested skips, content after the skipped container is still parsed and validated
+    TEST_CHECK(pts_skip_parse("{\"skip\":{},\"b\":{\"skip\":[[]]}}", &calls) == cj_error_none);
+    TEST_CHECK(calls == 4);
+    TEST_CHECK(pts_skip_parse("{\"skip\": [1] \"a\": 1}", &calls) == cj_error_exp_close_curly_bracket);
+    TEST_CHECK(pts_skip_parse("{\"skip\": [1, [2]", &calls) == cj_error_unexpected_eof);
+    TEST_CHECK(pts_skip_parse("{\"skip\": [\"]\\\"", &calls) == cj_error_unexpected_eof);
+
+    // the closing bracket has to match the kind of the open one
+    TEST_CHECK(pts_skip_parse("{\"a\":[1}, \"b\":2}", &calls) == cj_error_exp_close_square_bracket);
+    TEST_CHECK(pts_skip_parse("{\"a\":{1]}", &calls) == cj_error_exp_close_curly_bracket);
+    TEST_CHECK(pts_skip_parse("{\"a\":[{\"b\":[]]}, \"c\":2}", &calls) == cj_error_exp_close_curly_bracket);
+    TEST_CHECK(pts_skip_parse("{\"a\":[[\"}\"],{\"]\":{}}], \"c\":2}", &calls) == cj_error_none);
+
+    // long skipped containers run through the SIMD scan
+    char json[4096];
+    char* out = json;
+    out += sprintf(out, "{\"skip\": [");
+    for (int i = 0; i < 100; i++) {
+        out += sprintf(out, "%s{\"key %d\": \"value ]}\\\" %d\", \"n\": [%d]}", i ? ", " : "", i, i, i);
+    }
+    sprintf(out, "], \"a\": 1}");
+    TEST_CHECK(pts_skip_parse(json, &calls) == cj_error_none);
+    TEST_CHECK(calls == 2);
+
+    // skipped containers are limited to CJ_MAX_DEPTH like the parser
+    char* deep = malloc(2 * CJ_MAX_DEPTH + 16);
+    out = deep + sprintf(deep, "{\"skip\":");
+    memset(out, '[', CJ_MAX_DEPTH + 1);
+    memset(out + CJ_MAX_DEPTH + 1, ']', CJ_MAX_DEPTH + 1);
+    sprintf(out + 2 * CJ_MAX_DEPTH + 2, "}");
+    TEST_CHECK(pts_skip_parse(deep, &calls) == cj_error_max_depth); free(deep);
+}
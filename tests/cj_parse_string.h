@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_STRING \
+    {"cj_parse_string", test_cj_parse_string}, {"cj_parse_string_insitu", test_cj_parse_string_insitu}
+
+enum cj_error_code test_cj_parse_string_case(char* data, size_t* length) {
+    struct cj_value value = {0};
+    enum cj_error_code err = cj_parse_string(&data, data + strlen(data), &value);
+    *length = value.string.length;
+    return err;
+}
+
+void test_cj_parse_string() {
+    size_t len = 0;
+    TEST_ASSERT(test_cj_parse_string_case("\"\"", &len) == cj_error_none);
+    TEST_ASSERT(len == 2);
+    TEST_ASSERT(test_cj_parse_string_case("\"\\u0041\"", &len) == cj_error_none);
+    TEST_ASSERT(len == 8);
+    TEST_ASSERT(test_cj_parse_string_case("\"\\u0041\\u0042\",", &len) == cj_error_none);
+    TEST_ASSERT(len == 14);
+
+    // escapes and the closing quote at positions before, inside and after the 16 and 32 byte blocks
+    char* long_str = "\"0123456789abcdef0123456789abcdef0123456789abcdef\\\"0123456789abcdef\\n\\u00e4 tail\" rest";
+    TEST_ASSERT(test_cj_parse_string_case(long_str, &len) == cj_error_none);
+    TEST_ASSERT(len == strlen(long_str) - strlen(" rest"));
+
+    TEST_ASSERT(test_cj_parse_string_case("\"0123456789abcdef0123456789abcdef0123456789", &len) ==
+                cj_error_unexpected_eof);
+    TEST_ASSERT(test_cj_parse_string_case("\"0123456789abcdef0123456789abcdef\\", &len) == cj_error_unexpected_eof);
+    TEST_ASSERT(test_cj_parse_string_case("\"0123456789abcdef0123456789abcdef\\u00", &len) == cj_error_unexpected_eof);
+    TEST_ASSERT(test_cj_parse_string_case("\"0123456789abcdef0123456789abcdef\\x\"", &len) ==
+                cj_error_exp_escaped_character);
+    TEST_ASSERT(test_cj_parse_string_case("\"0123456789abcdef0123456789abcdef\\u00g0\"", &len) == cj_error_exp_hex);
+
+    // surrogates only come in pairs
+    TEST_ASSERT(test_cj_parse_string_case("\"\\uD83D\\uDE03\"", &len) == cj_error_none);
+    TEST_ASSERT(len == 14);
+    TEST_ASSERT(test_cj_parse_string_case("\"\\ud800\"", &len) == cj_error_unpaired_surrogate);
+    TEST_ASSERT(test_cj_parse_string_case("\"a\\udc00\"", &len) == cj_error_unpaired_surrogate);
+    TEST_ASSERT(test_cj_parse_string_case("\"\\ud800\\u0041\"", &len) == cj_error_unpaired_surrogate);
+    TEST_ASSERT(test_cj_parse_string_case("\"\\ud800\\n\"", &len) == cj_error_unpaired_surrogate);
+    TEST_ASSERT(test_cj_parse_string_case("\"\\ud800\\ud800\"", &len) == cj_error_unpaired_surrogate);
+    TEST_ASSERT(test_cj_parse_string_case("\"\\ud800\\udc0", &len) == cj_error_unexpected_eof);
+
+    // a string ending right before a page boundary
+    char* page = aligned_alloc(4096, 4096 * 2);
+    memset(page, 'x', 4096 * 2);
+    char* end = page + 4096 - 1;
+    char* start = end - 70;
+    start[0] = '"';
+    end[-1] = '"';
+    end[0] = '\0';
+    TEST_ASSERT(test_cj_parse_string_case(start, &len) == cj_error_none);
+    TEST_ASSERT(len == 70);
+    end[-1] = 'x';
+    TEST_ASSERT(test_cj_parse_string_case(start, &len) == cj_error_unexpected_eof);
+    free(page);
+}
+
+// The strings handed to push and set are logged as "<key>=<value> ", push logs "=<value> ".
+char tps_log[256];
+
+void tps_log_string(struct cj_span* id, struct cj_value* value) {
+    char* out = tps_log + strlen(tps_log);
+    if (id != NULL) {
+        out += sprintf(out, "%.*s", (int)id->length, id->ptr);
+    }
+    if (value->type == cj_type_string) {
+        sprintf(out, "=%.*s ", (int)value->string.length, value->string.ptr);
+    } else {
+        sprintf(out, "=# ");
+    }
+}
+
+enum cj_error_code tps_push(void* this, unsigned int tag, size_t index, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    (void)index;
+    tps_log_string(NULL, value);
+    return cj_error_none;
+}
+
+enum cj_error_code tps_set(void* this, unsigned int tag, struct cj_span* id, struct cj_value* value) {
+    (void)this;
+    (void)tag;
+    tps_log_string(id, value);
+    return cj_error_none;
+}
+
+void test_cj_parse_string_insitu() {
+    const char* json = "[\"k\\u00e4y\", {\"\\\"\": \"\\uD83D\\uDE03\", \"a\\tb\": \"plain\", \"\": \"\"}]";
+    struct cj_parser parser = {.open = cj_open_void, .push = tps_push, .set = tps_set};
+
+    // the callbacks see the decoded strings without quotes
+    char* insitu = strdup(json);
+    tps_log[0] = '\0';
+    TEST_ASSERT(cj_parse_array_into_insitu(&parser, insitu, strlen(insitu), NULL, 0).type == cj_error_none);
+    TEST_CHECK(strcmp(tps_log, "=k\u00e4y \"=\U0001F603 a\tb=plain = =# ") == 0);
+    TEST_MSG("got: %s", tps_log);
+    free(insitu);
+
+    // cj_parse_insitu is ignored by the const entry points, a string literal stays untouched
+    parser.flags = cj_parse_insitu;
+    tps_log[0] = '\0';
+    TEST_ASSERT(cj_parse_array_into_n(&parser, json, strlen(json), NULL, 0).type == cj_error_none);
+    TEST_CHECK(strcmp(tps_log, "=\"k\\u00e4y\" \"\\\"\"=\"\\uD83D\\uDE03\" \"a\\tb\"=\"plain\" \"\"=\"\" =# ") == 0);
+    TEST_MSG("got: %s", tps_log);
+    TEST_CHECK(cj_parse_array_into(&parser, "[\"a\\nb\"]", NULL, 0).type == cj_error_none);
+}
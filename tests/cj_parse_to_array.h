@@ -42,7 +42,7 @@ enum cj_error_code pta_set(void* this, unsigned int this_tag, struct cj_span* id
 }
 
 void test_cj_parse_to_array() {
-    struct cj_parser parser = {pta_open, cj_push_void, pta_set};
+    struct cj_parser parser = {.open = pta_open, .push = cj_push_void, .set = pta_set};
     struct person people[100];
     char* json =
         "[{\"lastName\":\"Smith\", \"firstName\":\"John\", \"age\": 89}, {\"lastName\":\"Morgen\", "
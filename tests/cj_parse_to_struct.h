@@ -80,7 +80,7 @@ enum cj_error_code pts_set(void* this, unsigned int tag, struct cj_span* id, str
 }
 
 void test_cj_parse_to_struct() {
-    struct cj_parser parser = {pts_open, pts_push, pts_set};
+    struct cj_parser parser = {.open = pts_open, .push = pts_push, .set = pts_set};
     struct project project = {0};
     char* json =
         "{ \"name\": \"My \\\"Project\\\"\", \"description\": \"This is a project!\", \"progress\": { "
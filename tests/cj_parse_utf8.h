@@ -0,0 +1,127 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_UTF8 {"cj_parse_utf8", test_cj_parse_utf8}, {"cj_parse_utf8_random", test_cj_parse_utf8_random}
+
+/**
+ * Reference validator decoding every code point, returns the offset of the first invalid sequence or len.
+ */
+size_t ptu_reference(const unsigned char* s, size_t len) {
+    size_t i = 0;
+    while (i < len) {
+        unsigned char c = s[i];
+        size_t n = c < 0x80 ? 1 : (c & 0xE0) == 0xC0 ? 2 : (c & 0xF0) == 0xE0 ? 3 : (c & 0xF8) == 0xF0 ? 4 : 0;
+        if (n == 0 || i + n > len) {
+            return i;
+        }
+        unsigned int cp = n == 1 ? c : c & (0x7F >> n);
+        for (size_t k = 1; k < n; k++) {
+            if ((s[i + k] & 0xC0) != 0x80) {
+                return i;
+            }
+            cp = cp << 6 | (s[i + k] & 0x3F);
+        }
+        unsigned int min[] = {0, 0, 0x80, 0x800, 0x10000};
+        if (cp < min[n] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) {
+            return i;
+        }
+        i += n;
+    }
+    return len;
+}
+
+void ptu_check(const char* s, size_t len) {
+    char* copy = malloc(len + 1);
+    memcpy(copy, s, len);
+    char* invalid = cj_utf8_validate(copy, copy + len);
+    size_t expected = ptu_reference((const unsigned char*)copy, len);
+    TEST_CHECK_((invalid == NULL ? len : (size_t)(invalid - copy)) == expected, "validate %zu bytes", len);
+    free(copy);
+}
+
+void test_cj_parse_utf8() {
+    const char* valid[] = {"", "plain ascii", "\xc3\xa4\xc3\xb6\xc3\xbc", "\xe2\x82\xac", "\xef\xbf\xbf",
+                           "\xf0\x90\x80\x80", "\xf4\x8f\xbf\xbf", "\xed\x9f\xbf", "\xee\x80\x80"};
+    const char* invalid[] = {
+        "\x80",             // stray continuation
+        "\xc0\x80",         // overlong 2
+        "\xc1\xbf",         // overlong 2
+        "\xe0\x9f\xbf",     // overlong 3
+        "\xf0\x8f\xbf\xbf", // overlong 4
+        "\xed\xa0\x80",     // surrogate
+        "\xf4\x90\x80\x80", // above U+10FFFF
+        "\xf5\x80\x80\x80", // invalid lead byte
+        "\xff",             // invalid byte
+        "\xc3",             // truncated
+        "\xe2\x82",         // truncated
+        "\xf0\x90\x80",     // truncated
+        "\xc3\xc3",         // missing continuation
+        "\xe2\x28\xa1",     // missing continuation
+    };
+    char buffer[128];
+    for (size_t offset = 0; offset < 70; offset += 3) {
+        memset(buffer, 'a', offset);
+        for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+            size_t len = strlen(valid[i]);
+            memcpy(buffer + offset, valid[i], len);
+            ptu_check(buffer, offset + len);
+            TEST_CHECK(cj_utf8_validate(buffer, buffer + offset + len) == NULL);
+        }
+        for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+            size_t len = strlen(invalid[i]);
+            memcpy(buffer + offset, invalid[i], len);
+            memset(buffer + offset + len, 'b', 40);
+            ptu_check(buffer, offset + len);
+            ptu_check(buffer, offset + len + 40);
+            TEST_CHECK(cj_utf8_validate(buffer, buffer + offset + len + 40) == buffer + offset);
+        }
+    }
+
+    // validation is off by default and checks keys, values and root strings when enabled
+    struct cj_parser parser = {.open = cj_open_void, .push = cj_push_void, .set = cj_set_void};
+    const char* bad_value = "{\"key\": [\"\xc3\xa4\", \"ok \xed\xa0\x80\"]}";
+    const char* bad_key = "{\"k\xff\": 1}";
+    TEST_CHECK(cj_parse_object_into_n(&parser, bad_value, strlen(bad_value), NULL, 0).type == cj_error_none);
+    parser.flags = cj_parse_validate_utf8;
+    struct cj_error err = cj_parse_object_into_n(&parser, bad_value, strlen(bad_value), NULL, 0);
+    TEST_CHECK(err.type == cj_error_invalid_utf8);
+    TEST_CHECK(err.stopped_at == bad_value + 19);
+    err = cj_parse_object_into_n(&parser, bad_key, strlen(bad_key), NULL, 0);
+    TEST_CHECK(err.type == cj_error_invalid_utf8);
+    TEST_CHECK(err.stopped_at == bad_key + 3);
+
+    struct cj_entity* e = cj_decode_flags(bad_value, strlen(bad_value), 0, &err);
+    TEST_CHECK(e != NULL);
+    cj_entity_free(e);
+    TEST_CHECK(cj_decode_flags(bad_value, strlen(bad_value), cj_parse_validate_utf8, &err) == NULL);
+    TEST_CHECK(err.type == cj_error_invalid_utf8);
+    TEST_CHECK(cj_decode_flags("\"\xc3\"", 4, cj_parse_validate_utf8, &err) == NULL);
+    TEST_CHECK(err.type == cj_error_invalid_utf8);
+    e = cj_decode_flags("\"\xc3\xa4\"", 4, cj_parse_validate_utf8, &err);
+    TEST_CHECK(e != NULL && err.type == cj_error_none);
+    cj_entity_free(e);
+}
+
+void test_cj_parse_utf8_random() {
+    static const char* pieces[] = {"a",    "\xc3\xa4",         "\xe2\x82\xac", "\xf0\x9f\x98\x80", "\xed\x9f\xbf",
+                                   "\x80", "\xe0\xa0",         "\xf4\x90",     "\xed\xa0\x80",     "\xc0\xaf",
+                                   "\xf8", "\xf0\x9f\x98\x80", "0123456789",   "\xef\xbb\xbf",     "\xdf\xbf"};
+    char buffer[512];
+    unsigned int seed = 7;
+    for (int i = 0; i < 20000; i++) {
+        size_t len = 0;
+        size_t count = rand_r(&seed) % 40;
+        // mostly valid input with a rare invalid piece
+        bool valid_only = rand_r(&seed) % 2;
+        for (size_t k = 0; k < count; k++) {
+            size_t piece = rand_r(&seed) % (valid_only ? 5 : 15);
+            size_t piece_len = strlen(pieces[piece]);
+            memcpy(buffer + len, pieces[piece], piece_len);
+            len += piece_len;
+        }
+        ptu_check(buffer, len);
+    }
+}
@@ -0,0 +1,44 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_PARSE_WHITESPACE {"cj_parse_whitespace", test_cj_parse_whitespace}
+
+void test_cj_parse_whitespace() {
+    char* json =
+        "{\n"
+        "                                        \"name\"  \t  :\r\n    \"indented\"   ,\n"
+        "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\"list\": [\n"
+        "                                                                         1,\n"
+        "        2 \r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n   ]\n"
+        "}";
+
+    struct cj_entity* obj = cj_decode(json, NULL);
+    TEST_ASSERT(obj != NULL);
+    TEST_ASSERT(strcmp(cj_entity_as_string(cj_entity_get_member(obj, "name")), "indented") == 0);
+    TEST_ASSERT(cj_entity_length(cj_entity_get_member(obj, "list")) == 2);
+    TEST_ASSERT(cj_entity_as_number(cj_entity_get_item(cj_entity_get_member(obj, "list"), 1)).integer == 2);
+    cj_entity_free(obj);
+
+    // white space running up to the end of a page must not be read past the terminating '\0'
+    char* page = aligned_alloc(4096, 4096 * 2);
+    memset(page, ' ', 4096 * 2);
+    char* end = page + 4096 + 7;
+    char* start = end - 100;
+    memcpy(start, "[1", 2);
+    memcpy(end - 1, "]", 2);
+    obj = cj_decode(start, NULL);
+    TEST_ASSERT(obj != NULL);
+    TEST_ASSERT(cj_entity_length(obj) == 1);
+    cj_entity_free(obj);
+
+    // ... and the parser has to stop at the '\0' inside a white space run
+    memcpy(end - 1, " ", 2);
+    struct cj_error err = {0};
+    obj = cj_decode(start, &err);
+    TEST_ASSERT(obj == NULL);
+    TEST_ASSERT(err.type != cj_error_none);
+    free(page);
+}
@@ -6,9 +6,10 @@
 #define CJ_TESTS_STR                                                                                            \
     {"test_cj_span_validate", test_cj_span_validate}, {"test_cj_span_len", test_cj_span_len},                   \
         {"test_cj_span_eq_basic", test_cj_span_eq_basic}, {"test_cj_span_eq_escaped", test_cj_span_eq_escaped}, \
-        {"test_cj_span_cpy", test_cj_span_cpy}, {"test_cj_span_dup", test_cj_span_dup}, {                       \
-        "test cj_span unicode support", test_cj_span_unicode                                                    \
-    }
+        {"test_cj_span_cpy", test_cj_span_cpy}, {"test_cj_span_dup", test_cj_span_dup},                         \
+        {"test cj_span unicode support", test_cj_span_unicode},                                                 \
+        {"test cj_span unicode bounded", test_cj_span_unicode_bounded},                                               \
+        {"test cj_span unescape", test_cj_span_unescape}, {"test cj_span info", test_cj_span_info}
 
 #include <stdlib.h>
 
@@ -37,7 +38,9 @@ bool test_cj_span_cpy_case(char* cjstr, char* str) {
     char* buffer = malloc(sizeof(char) * (len + 1));
     memset(buffer, 0, (len + 1));
     cj_span_cpy(&s, buffer, len + 1);
-    return strcmp(str, buffer) == 0;
+    bool ret = strcmp(str, buffer) == 0;
+    free(buffer);
+    return ret;
 }
 
 bool test_cj_span_cpy_case_n(char* cjstr, char* str, size_t buffer_size) {
@@ -46,7 +49,9 @@ bool test_cj_span_cpy_case_n(char* cjstr, char* str, size_t buffer_size) {
     char* buffer = malloc(sizeof(char) * buffer_size);
     memset(buffer, 0, buffer_size);
     cj_span_cpy(&s, buffer, buffer_size);
-    return strcmp(str, buffer) == 0;
+    bool ret = strcmp(str, buffer) == 0;
+    free(buffer);
+    return ret;
 }
 
 bool test_cj_span_dup_case(char* json, char* str) {
@@ -66,6 +71,13 @@ void test_cj_span_validate() {
     TEST_ASSERT(test_cj_span_validate_case("\"\\\"") == cj_error_unexpected_eof);
     // invalid 'a' is not escapable
     TEST_ASSERT(test_cj_span_validate_case("\"\\a\"") == cj_error_exp_escaped_character);
+    // invalid hex digits and surrogates without their other half
+    TEST_ASSERT(test_cj_span_validate_case("\"\\u12x4\"") == cj_error_exp_hex);
+    TEST_ASSERT(test_cj_span_validate_case("\"\\u12\"") == cj_error_exp_hex);
+    TEST_ASSERT(test_cj_span_validate_case("\"\\ud800\"") == cj_error_unpaired_surrogate);
+    TEST_ASSERT(test_cj_span_validate_case("\"\\udc00\"") == cj_error_unpaired_surrogate);
+    TEST_ASSERT(test_cj_span_validate_case("\"\\ud800\\u0041\"") == cj_error_unpaired_surrogate);
+    TEST_ASSERT(test_cj_span_validate_case("\"\\ud83d\\ude03\"") == cj_error_none);
 }
 
 void test_cj_span_len() {
@@ -156,3 +168,107 @@ void test_cj_span_unicode() {
     TEST_ASSERT(test_cj_span_eq_case("\"\\uD83D\\uDE03\"", "😃"));
 }
 
+void test_cj_span_unicode_bounded() {
+    // escapes are decoded against the end of the span, never the rest of the input
+    char input[] = "\"\\uD83D\"\\uDE03\"";
+    struct cj_span s = {.ptr = input, .length = 8};
+    TEST_CHECK(cj_span_validate(&s) == cj_error_unpaired_surrogate);
+
+    // spans at the very end of an exactly sized buffer
+    const char* json = "\"\\u00e4\\uD83D\\uDE03\"";
+    size_t length = strlen(json);
+    char* exact = malloc(length);
+    memcpy(exact, json, length);
+    s = (struct cj_span){.ptr = exact, .length = length};
+    TEST_CHECK(cj_span_validate(&s) == cj_error_none);
+    TEST_CHECK(cj_span_len(&s) == 6);
+    TEST_CHECK(cj_span_eq(&s, "\u00e4\U0001F603"));
+    char buffer[7];
+    cj_span_cpy(&s, buffer, sizeof(buffer));
+    TEST_CHECK(strcmp(buffer, "\u00e4\U0001F603") == 0);
+    free(exact);
+}
+
+bool test_cj_span_unescape_case(char* a, char* expected) {
+    // an exactly sized copy and buffer let the sanitizers catch reads or writes past the end
+    size_t length = strlen(a);
+    struct cj_span s = {.ptr = malloc(length), .length = length};
+    memcpy(s.ptr, a, length);
+    char* buffer = malloc(length - 1);
+
+    size_t decoded = cj_span_unescape(&s, buffer);
+    bool ret = decoded == strlen(expected) && strcmp(buffer, expected) == 0 && decoded == cj_span_len(&s);
+
+    free(buffer);
+    free(s.ptr);
+    return ret;
+}
+
+void test_cj_span_unescape() {
+    TEST_ASSERT(test_cj_span_unescape_case("\"\"", ""));
+    TEST_ASSERT(test_cj_span_unescape_case("\"no escapes at all\"", "no escapes at all"));
+    TEST_ASSERT(test_cj_span_unescape_case("\"\\n\"", "\n"));
+    TEST_ASSERT(test_cj_span_unescape_case("\"\\\\\\\"\\/\\b\\f\\n\\r\\t\"", "\\\"/\b\f\n\r\t"));
+    TEST_ASSERT(test_cj_span_unescape_case("\"run\\tand\\u00e4run\\u20acend\"", "run\tand\u00e4run\u20acend"));
+    TEST_ASSERT(test_cj_span_unescape_case("\"\\uD83D\\uDE03\"", "\U0001F603"));
+    TEST_ASSERT(test_cj_span_unescape_case("\"\\u0041\\u0042\"", "AB"));
+    TEST_ASSERT(test_cj_span_unescape_case("\"tail\\\\\"", "tail\\"));
+
+    // escapes the parser rejects are kept as they are instead of aborting
+    TEST_ASSERT(test_cj_span_unescape_case("\"\\ud800\"", "\\ud800"));
+    TEST_ASSERT(test_cj_span_unescape_case("\"a\\udc00\\n\"", "a\\udc00\n"));
+    TEST_ASSERT(test_cj_span_unescape_case("\"\\q\\u12\"", "\\q\\u12"));
+    struct cj_span broken = {.ptr = "\"x\\ud800\"", .length = 9};
+    TEST_CHECK(cj_span_eq(&broken, "x\\ud800"));
+    char copy[4];
+    cj_span_cpy(&broken, copy, sizeof(copy));
+    TEST_CHECK(strcmp(copy, "x\\u") == 0);
+
+    // cj_span_cpy with a large enough buffer takes the same path, a short one still truncates
+    struct cj_span s = {.ptr = "\"Hello\\tWorld\"", .length = 14};
+    char buffer[6];
+    cj_span_cpy(&s, buffer, sizeof(buffer));
+    TEST_ASSERT(strcmp(buffer, "Hello") == 0);
+}
+
+bool test_cj_span_info_case(char* json, bool escaped) {
+    char* b = json;
+    struct cj_value value = {0};
+    if (cj_parse_string(&b, json + strlen(json), &value) != cj_error_none) {
+        return false;
+    }
+    struct cj_span* s = &value.string;
+    // a copy without info takes the decoding path
+    struct cj_span plain = {.ptr = s->ptr, .length = s->length};
+    char* expected = cj_span_dup(&plain);
+    char* decoded = cj_span_dup(s);
+
+    bool ret = s->info == (cj_span_info_scanned | (escaped ? cj_span_info_escaped : 0)) &&
+               s->decoded_length == cj_span_len(&plain) && strcmp(decoded, expected) == 0 &&
+               cj_span_eq(s, expected) && cj_span_len(s) == strlen(expected);
+
+    free(decoded);
+    free(expected);
+    return ret;
+}
+
+void test_cj_span_info() {
+    TEST_ASSERT(test_cj_span_info_case("\"\"", false));
+    TEST_ASSERT(test_cj_span_info_case("\"no escapes at all\"", false));
+    TEST_ASSERT(test_cj_span_info_case("\"\\t\"", true));
+    TEST_ASSERT(test_cj_span_info_case("\"\\u0041\\u00e4\\u20ac\"", true));
+    TEST_ASSERT(test_cj_span_info_case("\"\\uE000\\uFFFD\"", true));
+    TEST_ASSERT(test_cj_span_info_case("\"a\\uD83D\\uDE03b\\uDBFF\\uDFFF\"", true));
+
+    char* b = "\"\\uD83D\\uDE03\"";
+    struct cj_value value = {0};
+    TEST_ASSERT(cj_parse_string(&b, b + strlen(b), &value) == cj_error_none);
+    TEST_CHECK(value.string.decoded_length == 4);
+
+    // escape free spans are compared without decoding, the length check still rejects prefixes
+    b = "\"Hello\"";
+    TEST_ASSERT(cj_parse_string(&b, b + strlen(b), &value) == cj_error_none);
+    TEST_CHECK(cj_span_eq(&value.string, "Hello"));
+    TEST_CHECK(!cj_span_eq(&value.string, "Hell"));
+    TEST_CHECK(!cj_span_eq(&value.string, "Hellp"));
+}
@@ -0,0 +1,99 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cj.h"
+#include "acutest.h"
+
+#define CJ_TESTS_VALIDATE {"cj_validate", test_cj_validate}
+
+void test_cj_validate() {
+    const char* valid[] = {
+        "{}",
+        "[]",
+        " { } ",
+        "[ \n ]",
+        "\"string\"",
+        "-0.5e+3",
+        "0",
+        "true",
+        "false",
+        "null",
+        "\n\t[1, -2.5, 3e10, true, false, null, \"\\u00e4\\\"\\\\\", {}, []]\r\n",
+        "{\"a\": {\"b\": [1, {\"c\": null}], \"d\": \"}]\"}, \"e\": []}",
+        "[\"\\uD83D\\uDE03\\udbff\\udfff\"]",
+        "[0, -0, 0.5, -0e1, 10]",
+    };
+    for (size_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++) {
+        struct cj_error err = {.type = cj_error_unexpected_input};
+        TEST_CHECK_(cj_validate(valid[i], strlen(valid[i]), &err), "'%s' is valid", valid[i]);
+        TEST_CHECK(err.type == cj_error_none);
+    }
+
+    struct {
+        const char* json;
+        enum cj_error_code type;
+        size_t stopped_at;
+    } invalid[] = {
+        {"", cj_error_exp_value, 0},
+        {"   ", cj_error_exp_value, 3},
+        {"{", cj_error_unexpected_eof, 1},
+        {"[1,]", cj_error_exp_value, 3},
+        {"{\"a\":1,}", cj_error_exp_quote, 7},
+        {"{\"a\" 1}", cj_error_exp_colon, 5},
+        {"{1:2}", cj_error_exp_quote, 1},
+        {"[1 2]", cj_error_exp_close_square_bracket, 3},
+        {"{\"a\":1]", cj_error_exp_close_curly_bracket, 6},
+        {"[truex]", cj_error_exp_close_square_bracket, 5},
+        {"[nul]", cj_error_exp_value, 1},
+        {"[-]", cj_error_exp_digits, 2},
+        {"[1.]", cj_error_exp_digits, 3},
+        {"[\"\\q\"]", cj_error_exp_escaped_character, 3},
+        {"[\"\\u12x4\"]", cj_error_exp_hex, 6},
+        {"[\"\\ud800\"]", cj_error_unpaired_surrogate, 2},
+        {"[\"ab\\udfff\"]", cj_error_unpaired_surrogate, 4},
+        {"[\"\\ud800\\u0041\"]", cj_error_unpaired_surrogate, 2},
+        {"[01]", cj_error_exp_close_square_bracket, 2},
+        {"[-01]", cj_error_exp_close_square_bracket, 3},
+        {"[-00]", cj_error_exp_close_square_bracket, 3},
+        {"{\"a\": 00}", cj_error_exp_close_curly_bracket, 7},
+        {"[\"\x01\"]", cj_error_control_character, 2},
+        {"[\"a\x01\nb\"]", cj_error_control_character, 3},
+        {"[\"0123456789abcdef0123456789abcdef\tx\"]", cj_error_control_character, 34},
+        {"[\"abc", cj_error_unexpected_eof, 5},
+        {"{} {}", cj_error_unexpected_input, 3},
+        {"1 2", cj_error_unexpected_input, 2},
+        {"x", cj_error_exp_value, 0},
+    };
+    for (size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++) {
+        struct cj_error err;
+        TEST_CHECK_(!cj_validate(invalid[i].json, strlen(invalid[i].json), &err), "'%s' is invalid", invalid[i].json);
+        TEST_CHECK_(err.type == invalid[i].type, "'%s' error %d", invalid[i].json, err.type);
+        TEST_CHECK_(err.stopped_at == invalid[i].json + invalid[i].stopped_at, "'%s' stopped at %zu", invalid[i].json,
+                    (size_t)(err.stopped_at - invalid[i].json));
+    }
+    TEST_CHECK(!cj_validate("[1]", 2, NULL));
+
+    // nesting is limited by CJ_MAX_DEPTH
+    char* json = malloc(CJ_MAX_DEPTH * 2 + 2);
+    for (size_t depth = CJ_MAX_DEPTH; depth <= CJ_MAX_DEPTH + 1; depth++) {
+        memset(json, '[', depth);
+        memset(json + depth, ']', depth);
+        struct cj_error err;
+        bool ok = cj_validate(json, 2 * depth, &err);
+        TEST_CHECK(ok == (depth <= CJ_MAX_DEPTH));
+        TEST_CHECK(ok || err.type == cj_error_max_depth);
+    }
+    free(json);
+
+    // nested objects and arrays switching kinds above 64 levels
+    char deep[1024] = {0};
+    char* out = deep;
+    for (int i = 0; i < 100; i++) {
+        out += sprintf(out, i % 3 ? "[" : "{\"k\":");
+    }
+    out += sprintf(out, "1");
+    for (int i = 99; i >= 0; i--) {
+        out += sprintf(out, i % 3 ? "]" : "}");
+    }
+    TEST_CHECK(cj_validate(deep, strlen(deep), NULL));
+}